@@ -0,0 +1,435 @@
+// fly_score_bench: cost of the state save/load path as the state grows.
+//
+// Prints one JSON object per line (scenario x parameters) on stdout, e.g.
+//   {"bench":"save","fields":1024,"timers":32,"label_len":16,"iters":812,
+//    "ns_per_op":246113.2,"allocs_per_op":3121,"alloc_bytes_per_op":402311,"bytes":88120}
+// Log lines from the core go to stderr, so stdout can be piped straight into
+// a regression checker.
+//
+// Usage:
+//   fly_score_bench [--fields 2,32,1024] [--timers 1,32,1024] [--label-len 16]
+//                   [--min-ms 200] [--write-rates 50,500] [--duration-ms 500]
+//                   [--fsync] [--only to_json,save,...]
+//
+// Scenarios: to_json, from_json, serialize (to_json + compact bytes), parse
+// (bytes -> FlyState), save (fly_state_save), load (fly_state_load) and
+// persist (FlyStatePersister fed at each write rate).
+
+#include "fly_score_persist.hpp"
+#include "fly_score_state.hpp"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Allocation counting
+//
+// Qt containers allocate with malloc, not operator new, so on glibc the malloc
+// family itself is interposed (operator new ends up there too). Elsewhere only
+// operator new is counted, which undercounts Qt's allocations.
+// -----------------------------------------------------------------------------
+
+static std::atomic<uint64_t> g_allocs{0};
+static std::atomic<uint64_t> g_allocBytes{0};
+
+static inline void count_alloc(size_t n)
+{
+	g_allocs.fetch_add(1, std::memory_order_relaxed);
+	g_allocBytes.fetch_add(n, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(size_t n);
+void *__libc_calloc(size_t c, size_t n);
+void *__libc_realloc(void *p, size_t n);
+void __libc_free(void *p);
+
+void *malloc(size_t n) noexcept
+{
+	count_alloc(n);
+	return __libc_malloc(n);
+}
+
+void *calloc(size_t c, size_t n) noexcept
+{
+	count_alloc(c * n);
+	return __libc_calloc(c, n);
+}
+
+void *realloc(void *p, size_t n) noexcept
+{
+	count_alloc(n);
+	return __libc_realloc(p, n);
+}
+
+void free(void *p) noexcept
+{
+	__libc_free(p);
+}
+}
+#else
+void *operator new(size_t n)
+{
+	count_alloc(n);
+	if (void *p = std::malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void *operator new[](size_t n)
+{
+	return operator new(n);
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+	std::free(p);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Options
+// -----------------------------------------------------------------------------
+
+struct BenchOptions {
+	std::vector<int> fields{2, 32, 1024};
+	std::vector<int> timers{1, 32, 1024};
+	int labelLen = 16;
+	int minMs = 200;
+	std::vector<int> writeRates{50, 500};
+	int durationMs = 500;
+	bool fsync = false;
+	QStringList only;
+};
+
+static std::vector<int> parse_int_list(const char *s)
+{
+	std::vector<int> out;
+	for (const QString &part : QString::fromUtf8(s).split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+		bool ok = false;
+		const int v = part.trimmed().toInt(&ok);
+		if (ok && v >= 0)
+			out.push_back(v);
+	}
+	return out;
+}
+
+static bool parse_args(int argc, char **argv, BenchOptions &o)
+{
+	for (int i = 1; i < argc; ++i) {
+		const char *a = argv[i];
+		const char *v = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (!std::strcmp(a, "--fsync")) {
+			o.fsync = true;
+			continue;
+		}
+		if (!v) {
+			std::fprintf(stderr, "missing value for %s\n", a);
+			return false;
+		}
+		++i;
+
+		if (!std::strcmp(a, "--fields"))
+			o.fields = parse_int_list(v);
+		else if (!std::strcmp(a, "--timers"))
+			o.timers = parse_int_list(v);
+		else if (!std::strcmp(a, "--label-len"))
+			o.labelLen = std::max(0, std::atoi(v));
+		else if (!std::strcmp(a, "--min-ms"))
+			o.minMs = std::max(1, std::atoi(v));
+		else if (!std::strcmp(a, "--write-rates"))
+			o.writeRates = parse_int_list(v);
+		else if (!std::strcmp(a, "--duration-ms"))
+			o.durationMs = std::max(1, std::atoi(v));
+		else if (!std::strcmp(a, "--only"))
+			o.only = QString::fromUtf8(v).split(QLatin1Char(','), Qt::SkipEmptyParts);
+		else {
+			std::fprintf(stderr, "unknown option %s\n", a);
+			return false;
+		}
+	}
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+// Fixtures
+// -----------------------------------------------------------------------------
+
+static QString make_label(int len, int seed)
+{
+	QString s(len, QLatin1Char('a'));
+	for (int i = 0; i < len; ++i)
+		s[i] = QLatin1Char(char('a' + (seed + i) % 26));
+	return s;
+}
+
+static FlyState make_state(int fields, int timers, int labelLen)
+{
+	FlyState st = fly_state_make_defaults();
+	st.home.title = make_label(labelLen, 1);
+	st.home.subtitle = make_label(3, 2);
+	st.home.logo = QStringLiteral("home-0123abcd.png");
+	st.away.title = make_label(labelLen, 3);
+	st.away.subtitle = make_label(3, 4);
+	st.away.logo = QStringLiteral("guest-4567ef01.png");
+
+	st.custom_fields.clear();
+	for (int i = 0; i < fields; ++i) {
+		FlyCustomField f;
+		f.label = make_label(labelLen, i);
+		f.home = i % 100;
+		f.away = (i * 7) % 100;
+		f.visible = (i % 3) != 0;
+		st.custom_fields.push_back(f);
+	}
+
+	st.timers.clear();
+	for (int i = 0; i < timers; ++i) {
+		FlyTimer t;
+		t.label = make_label(labelLen, i + 13);
+		t.mode = (i % 2) ? FlyTimerMode::Countup : FlyTimerMode::Countdown;
+		t.initial_ms = 20 * 60 * 1000;
+		t.remaining_ms = t.initial_ms - i * 1000;
+		t.running = (i % 4) == 0;
+		t.last_tick_ms = t.running ? 1700000000000LL + i : 0;
+		st.timers.push_back(t);
+	}
+	return st;
+}
+
+// -----------------------------------------------------------------------------
+// Measurement
+// -----------------------------------------------------------------------------
+
+struct BenchResult {
+	uint64_t iters = 0;
+	double nsPerOp = 0;
+	double allocsPerOp = 0;
+	double allocBytesPerOp = 0;
+};
+
+template<typename Op> static BenchResult run_timed(int minMs, Op &&op)
+{
+	using clock = std::chrono::steady_clock;
+
+	op(); // warm-up: first-touch allocations, page cache, ...
+
+	const uint64_t a0 = g_allocs.load();
+	const uint64_t b0 = g_allocBytes.load();
+	const auto t0 = clock::now();
+	const auto until = t0 + std::chrono::milliseconds(minMs);
+
+	uint64_t iters = 0;
+	auto t1 = t0;
+	do {
+		op();
+		++iters;
+		t1 = clock::now();
+	} while (t1 < until);
+
+	BenchResult r;
+	r.iters = iters;
+	r.nsPerOp = double(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) / double(iters);
+	r.allocsPerOp = double(g_allocs.load() - a0) / double(iters);
+	r.allocBytesPerOp = double(g_allocBytes.load() - b0) / double(iters);
+	return r;
+}
+
+static void emit_line(const QJsonObject &o)
+{
+	const QByteArray line = QJsonDocument(o).toJson(QJsonDocument::Compact);
+	std::fwrite(line.constData(), 1, size_t(line.size()), stdout);
+	std::fputc('\n', stdout);
+	std::fflush(stdout);
+}
+
+static QJsonObject base_line(const char *bench, int fields, int timers, int labelLen)
+{
+	QJsonObject o;
+	o["bench"] = QString::fromLatin1(bench);
+	o["fields"] = fields;
+	o["timers"] = timers;
+	o["label_len"] = labelLen;
+	return o;
+}
+
+static void emit_result(const char *bench, int fields, int timers, int labelLen, const BenchResult &r,
+			qint64 bytes)
+{
+	QJsonObject o = base_line(bench, fields, timers, labelLen);
+	o["iters"] = double(r.iters);
+	o["ns_per_op"] = r.nsPerOp;
+	o["allocs_per_op"] = r.allocsPerOp;
+	o["alloc_bytes_per_op"] = r.allocBytesPerOp;
+	o["bytes"] = double(bytes);
+	emit_line(o);
+}
+
+// -----------------------------------------------------------------------------
+// Scenarios
+// -----------------------------------------------------------------------------
+
+static void bench_persist(const BenchOptions &opt, const QString &dir, const FlyState &base, int fields, int timers)
+{
+	for (int rate : opt.writeRates) {
+		if (rate <= 0)
+			continue;
+
+		FlyState st = base;
+		FlyStatePersister persist;
+
+		const auto period = std::chrono::nanoseconds(1000000000LL / rate);
+		const auto t0 = std::chrono::steady_clock::now();
+		const auto until = t0 + std::chrono::milliseconds(opt.durationMs);
+
+		uint64_t submitNs = 0;
+		uint64_t submits = 0;
+		auto next = t0;
+		while (next < until) {
+			if (!st.custom_fields.isEmpty())
+				st.custom_fields[0].home = int(submits % 100);
+
+			const auto s0 = std::chrono::steady_clock::now();
+			persist.submit(dir, st);
+			submitNs += uint64_t(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s0)
+					.count());
+			++submits;
+
+			next += period;
+			std::this_thread::sleep_until(next);
+		}
+		persist.flush();
+
+		const FlyStatePersister::Stats s = persist.stats();
+		const qint64 fileBytes = QFileInfo(QDir(dir).filePath(QStringLiteral("plugin.json"))).size();
+
+		QJsonObject o = base_line("persist", fields, timers, opt.labelLen);
+		o["write_rate_hz"] = rate;
+		o["duration_ms"] = opt.durationMs;
+		o["coalesce_ms"] = persist.coalesceWindowMs();
+		o["submitted"] = double(s.submitted);
+		o["written"] = double(s.written);
+		o["coalesced"] = double(s.coalesced);
+		o["failed"] = double(s.failed);
+		o["submit_ns_per_op"] = submits ? double(submitNs) / double(submits) : 0.0;
+		o["max_write_us"] = double(s.max_write_us);
+		o["bytes_written"] = double(s.written) * double(fileBytes);
+		emit_line(o);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	BenchOptions opt;
+	if (!parse_args(argc, argv, opt))
+		return 2;
+
+	QTemporaryDir tmp;
+	if (!tmp.isValid()) {
+		std::fprintf(stderr, "cannot create a temporary directory\n");
+		return 1;
+	}
+	const QString dir = tmp.path();
+
+	fly_state_set_fsync_policy(opt.fsync ? FlyFsyncPolicy::Always : FlyFsyncPolicy::None);
+
+	auto enabled = [&opt](const char *name) {
+		return opt.only.isEmpty() || opt.only.contains(QString::fromLatin1(name));
+	};
+
+	for (int fields : opt.fields) {
+		for (int timers : opt.timers) {
+			const FlyState st = make_state(fields, timers, opt.labelLen);
+			const QJsonObject obj = fly_state_to_json(st);
+			const QByteArray bytes = fly_state_serialize(st);
+
+			if (enabled("to_json")) {
+				const BenchResult r = run_timed(opt.minMs, [&]() {
+					const QJsonObject o = fly_state_to_json(st);
+					(void)o;
+				});
+				emit_result("to_json", fields, timers, opt.labelLen, r, 0);
+			}
+
+			if (enabled("from_json")) {
+				const BenchResult r = run_timed(opt.minMs, [&]() {
+					FlyState out;
+					fly_state_from_json(obj, out);
+				});
+				emit_result("from_json", fields, timers, opt.labelLen, r, 0);
+			}
+
+			if (enabled("serialize")) {
+				const BenchResult r = run_timed(opt.minMs, [&]() {
+					const QByteArray b = fly_state_serialize(st);
+					(void)b;
+				});
+				emit_result("serialize", fields, timers, opt.labelLen, r, bytes.size());
+			}
+
+			if (enabled("parse")) {
+				const BenchResult r = run_timed(opt.minMs, [&]() {
+					FlyState out;
+					fly_state_from_json(QJsonDocument::fromJson(bytes).object(), out);
+				});
+				emit_result("parse", fields, timers, opt.labelLen, r, bytes.size());
+			}
+
+			if (enabled("save")) {
+				const BenchResult r = run_timed(opt.minMs, [&]() { fly_state_save(dir, st); });
+				const qint64 written =
+					QFileInfo(QDir(dir).filePath(QStringLiteral("plugin.json"))).size();
+				emit_result("save", fields, timers, opt.labelLen, r, written);
+			}
+
+			if (enabled("load")) {
+				fly_state_save(dir, st);
+				const qint64 read = QFileInfo(QDir(dir).filePath(QStringLiteral("plugin.json"))).size();
+				const BenchResult r = run_timed(opt.minMs, [&]() {
+					FlyState out;
+					fly_state_load(dir, out);
+				});
+				emit_result("load", fields, timers, opt.labelLen, r, read);
+			}
+
+			if (enabled("persist"))
+				bench_persist(opt, dir, st, fields, timers);
+		}
+	}
+
+	return 0;
+}
@@ -9,11 +9,51 @@ function mmss(ms) {
 }
 
 async function fetchState() {
-  const res = await fetch("plugin.json", { cache: "no-store" });
+  // Over HTTP the plugin can answer with a patch from our revision
+  const url =
+    location.protocol.startsWith("http") && currentRev
+      ? `state?since=${currentRev}`
+      : "plugin.json";
+  const res = await fetch(url, { cache: "no-store" });
   if (!res.ok) throw new Error("fetch failed");
   return await res.json();
 }
 
+// The plugin stamps running timers with a wall-clock anchor (last_tick_ms).
+// It is converted to this page's monotonic clock once, the first time it is
+// seen, so a clock step on this machine afterwards cannot move the timer.
+const timerAnchors = new Map();
+
+function monotonicAnchor(lastTick) {
+  let anchor = timerAnchors.get(lastTick);
+  if (anchor === undefined) {
+    anchor = performance.now() - Math.max(0, Date.now() - lastTick);
+    timerAnchors.set(lastTick, anchor);
+    if (timerAnchors.size > 64) {
+      timerAnchors.delete(timerAnchors.keys().next().value);
+    }
+  }
+  return anchor;
+}
+
+/**
+ * CSS classes for a countdown that has crossed an alarm threshold:
+ * "is-expired" at 0, otherwise "is-alarm alarm-N" where N is the index of
+ * the tightest threshold passed (ascending, so alarm-0 is the most urgent
+ * non-zero one). Empty for countups and timers above every threshold.
+ */
+function alarmClass(timer, thresholds) {
+  if (!timer || timer.mode !== 'countdown' || !thresholds.length) return '';
+  const ms = timer.live_ms;
+  if (ms <= 0) return thresholds[0] === 0 ? 'is-expired' : '';
+
+  const positive = thresholds.filter((v) => v > 0);
+  for (let i = 0; i < positive.length; i++) {
+    if (ms <= positive[i]) return 'is-alarm alarm-' + i;
+  }
+  return '';
+}
+
 function liveTimerMs(timer) {
   if (!timer) return 0;
 
@@ -27,8 +67,7 @@ function liveTimerMs(timer) {
     return baseRemaining;
   }
 
-  const now = Date.now();
-  const delta = now - lastTick;
+  const delta = performance.now() - monotonicAnchor(lastTick);
 
   if (mode === "countup") {
     return baseRemaining + delta;
@@ -39,27 +78,37 @@ function liveTimerMs(timer) {
 }
 
 // -----------------------------------------------------------------------------
-// Expression engine
+// Expression compiler
 // -----------------------------------------------------------------------------
-function resolvePath(obj, path) {
-  if (!obj || !path) return undefined;
-
+// Expressions are compiled once, when the bindings are collected. Every state
+// path they read becomes a dependency slot, shared by all bindings that read
+// the same path the same way. Per frame, only the slots are resolved; a
+// binding is re-evaluated only when one of its slots changed.
+
+// Parse a path (team_x.logo, timers[0].mmss, ...) once into a getter
+function compilePath(path) {
+  const steps = [];
   const re = /([^[.\]]+)|\[(\d+)\]/g;
-  let cur = obj;
   let m;
-
   while ((m = re.exec(path)) !== null) {
-    if (m[1]) {
-      cur = cur ? cur[m[1]] : undefined;
-    } else if (m[2]) {
-      const idx = Number(m[2]);
-      if (!Array.isArray(cur)) return undefined;
-      cur = cur[idx];
-    }
-    if (cur == null) return cur;
+    if (m[1]) steps.push({ key: m[1], index: false });
+    else if (m[2]) steps.push({ key: Number(m[2]), index: true });
   }
 
-  return cur;
+  return (obj) => {
+    if (!obj || !steps.length) return undefined;
+    let cur = obj;
+    for (const s of steps) {
+      if (s.index) {
+        if (!Array.isArray(cur)) return undefined;
+        cur = cur[s.key];
+      } else {
+        cur = cur ? cur[s.key] : undefined;
+      }
+      if (cur == null) return cur;
+    }
+    return cur;
+  };
 }
 
 function stripQuotes(s) {
@@ -86,121 +135,105 @@ function intToHex(colorInt) {
   return "#" + hex;
 }
 
-/**
- * Evaluate an expression used inside {{ ... }} for text/attributes.
- * Supports:
- *   path                → team_x.logo, timers[0].mmss, fields_xy[1].x, etc.
- *   cond ? 'a' : 'b'    → swap_sides ? 'foo' : 'bar'
- *   !path               → returns boolean true/false, but will get stringified when used
- */
-function evaluateExpression(expr, data) {
-  if (!expr) return "";
+// Dependency slots. A slot's value is always a primitive (a truthiness or the
+// text of a path), so "changed" is a plain !== against the last frame.
+const depSlots = [];
+const depSlotIndex = new Map();
+const NOT_READ = {};
+
+function depSlot(path, mode) {
+  const id = `${mode}:${path}`;
+  let idx = depSlotIndex.get(id);
+  if (idx === undefined) {
+    const get = compilePath(path);
+    const read =
+      mode === "truthy"
+        ? (data) => isTruthyValue(get(data))
+        : (data) => {
+          const v = get(data);
+          return v == null ? "" : String(v);
+        };
+    idx = depSlots.length;
+    depSlots.push({ read, value: NOT_READ, changed: true });
+    depSlotIndex.set(id, idx);
+  }
+  return idx;
+}
 
-  expr = expr.trim();
+// Resolve every slot against this frame's view; returns whether any changed
+function updateDepSlots(data) {
+  let any = false;
+  for (const slot of depSlots) {
+    const v = slot.read(data);
+    slot.changed = v !== slot.value;
+    if (slot.changed) {
+      slot.value = v;
+      any = true;
+    }
+  }
+  return any;
+}
 
-  // Ternary: cond ? 'a' : 'b'
-  const ternaryMatch = expr.match(
-    /^(.+?)\s*\?\s*(['"].*?['"])\s*:\s*(['"].*?['"])$/
-  );
-  if (ternaryMatch) {
-    const condExpr = ternaryMatch[1].trim();
-    const trueLit = stripQuotes(ternaryMatch[2]);
-    const falseLit = stripQuotes(ternaryMatch[3]);
+function tokenizeBoolExpr(s) {
+  const tokens = [];
+  let i = 0;
 
-    const ok = evaluateCondition(condExpr, data);
-    return ok ? trueLit : falseLit;
-  }
+  while (i < s.length) {
+    const c = s[i];
 
-  // Simple boolean: !path (returns true/false)
-  if (expr.startsWith("!")) {
-    const val = resolvePath(data, expr.slice(1).trim());
-    return !isTruthyValue(val);
+    if (/\s/.test(c)) {
+      i++;
+      continue;
+    }
+
+    if (c === "(" || c === ")" || c === "!") {
+      tokens.push(c);
+      i++;
+      continue;
+    }
+
+    if (s.startsWith("&&", i) || s.startsWith("||", i)) {
+      tokens.push(s.slice(i, i + 2));
+      i += 2;
+      continue;
+    }
+
+    // Path token: read until whitespace or operator/parens
+    const start = i;
+    while (i < s.length) {
+      if (/\s/.test(s[i])) break;
+      if (s.startsWith("&&", i) || s.startsWith("||", i)) break;
+      if (s[i] === "!" || s[i] === "(" || s[i] === ")") break;
+      i++;
+    }
+    tokens.push(s.slice(start, i));
   }
 
-  // Simple path
-  const v = resolvePath(data, expr);
-  return v == null ? "" : v;
+  return tokens;
 }
 
 /**
- * Advanced boolean evaluator for fs-if and ternary conditions.
+ * Compile a boolean expression for fs-if and ternary conditions.
  * Supports:
  *   - path (fields_xy[2].visible)
  *   - !path
  *   - &&, ||
  *   - parentheses (...)
  * Precedence: ! > && > ||
+ * Returns (vals) => boolean over the slot values, plus the slots it reads.
  */
-function evaluateCondition(expr, data) {
-  if (!expr) return false;
-  expr = expr.trim();
-  if (!expr) return false;
-
-  // ---------------------------
-  // Tokenizer
-  // ---------------------------
-  function tokenizeBoolExpr(s) {
-    const tokens = [];
-    let i = 0;
+function compileCondition(expr, deps) {
+  expr = (expr || "").trim();
+  if (!expr) return () => false;
 
-    while (i < s.length) {
-      const c = s[i];
-
-      if (/\s/.test(c)) {
-        i++;
-        continue;
-      }
-
-      if (c === "(" || c === ")") {
-        tokens.push(c);
-        i++;
-        continue;
-      }
-
-      if (c === "!") {
-        tokens.push("!");
-        i++;
-        continue;
-      }
-
-      if (s.startsWith("&&", i)) {
-        tokens.push("&&");
-        i += 2;
-        continue;
-      }
-
-      if (s.startsWith("||", i)) {
-        tokens.push("||");
-        i += 2;
-        continue;
-      }
-
-      // Path token: read until whitespace or operator/parens
-      const start = i;
-      while (i < s.length) {
-        if (/\s/.test(s[i])) break;
-        if (s.startsWith("&&", i) || s.startsWith("||", i)) break;
-        if (s[i] === "!" || s[i] === "(" || s[i] === ")") break;
-        i++;
-      }
-      tokens.push(s.slice(start, i));
-    }
-
-    return tokens;
-  }
-
-  const tokens = tokenizeBoolExpr(expr);
-
-  // ---------------------------
   // Shunting-yard to RPN
-  // ---------------------------
   const prec = { "!": 3, "&&": 2, "||": 1 };
   const rightAssoc = { "!": true };
 
   const out = [];
   const ops = [];
 
-  for (const t of tokens) {
+  for (const t of tokenizeBoolExpr(expr)) {
     if (t === "(") {
       ops.push(t);
       continue;
@@ -236,31 +269,68 @@ function evaluateCondition(expr, data) {
 
   while (ops.length) out.push(ops.pop());
 
-  // ---------------------------
-  // Evaluate RPN
-  // ---------------------------
+  // RPN to a closure tree; missing operands read as false, as before
+  const never = () => false;
   const stack = [];
 
   for (const tok of out) {
     if (tok === "!") {
-      const a = stack.pop() || false;
-      stack.push(!a);
+      const a = stack.pop() || never;
+      stack.push((v) => !a(v));
       continue;
     }
 
     if (tok === "&&" || tok === "||") {
-      const b = stack.pop() || false;
-      const a = stack.pop() || false;
-      stack.push(tok === "&&" ? (a && b) : (a || b));
+      const b = stack.pop() || never;
+      const a = stack.pop() || never;
+      stack.push(
+        tok === "&&" ? (v) => !!(a(v) && b(v)) : (v) => !!(a(v) || b(v))
+      );
       continue;
     }
 
-    // resolve path -> truthy
-    const val = resolvePath(data, tok);
-    stack.push(isTruthyValue(val));
+    const idx = depSlot(tok, "truthy");
+    deps.add(idx);
+    stack.push((v) => v[idx]);
+  }
+
+  return stack.pop() || never;
+}
+
+/**
+ * Compile an expression used inside {{ ... }} for text/attributes.
+ * Supports:
+ *   path                → team_x.logo, timers[0].mmss, fields_xy[1].x, etc.
+ *   cond ? 'a' : 'b'    → swap_sides ? 'foo' : 'bar'
+ *   !path               → "true"/"false"
+ * Returns (vals) => string.
+ */
+function compileExpression(expr, deps) {
+  expr = (expr || "").trim();
+  if (!expr) return () => "";
+
+  // Ternary: cond ? 'a' : 'b'
+  const ternaryMatch = expr.match(
+    /^(.+?)\s*\?\s*(['"].*?['"])\s*:\s*(['"].*?['"])$/
+  );
+  if (ternaryMatch) {
+    const cond = compileCondition(ternaryMatch[1], deps);
+    const trueLit = stripQuotes(ternaryMatch[2]);
+    const falseLit = stripQuotes(ternaryMatch[3]);
+    return (v) => (cond(v) ? trueLit : falseLit);
+  }
+
+  // Simple boolean: !path
+  if (expr.startsWith("!")) {
+    const idx = depSlot(expr.slice(1).trim(), "truthy");
+    deps.add(idx);
+    return (v) => String(!v[idx]);
   }
 
-  return stack.pop() || false;
+  // Simple path
+  const idx = depSlot(expr, "text");
+  deps.add(idx);
+  return (v) => v[idx];
 }
 
 // -----------------------------------------------------------------------------
@@ -271,34 +341,27 @@ const ifBindings = [];
 
 function createBinding(targetNode, kind, attrName, templateString) {
   const parts = [];
+  const deps = new Set();
   const regex = /{{\s*([^}]+?)\s*}}/g;
   let lastIndex = 0;
   let match;
 
   while ((match = regex.exec(templateString)) !== null) {
     if (match.index > lastIndex) {
-      parts.push({
-        type: "literal",
-        value: templateString.slice(lastIndex, match.index),
-      });
+      parts.push(templateString.slice(lastIndex, match.index));
     }
-    parts.push({
-      type: "expr",
-      value: match[1].trim(),
-    });
+    parts.push(compileExpression(match[1], deps));
     lastIndex = regex.lastIndex;
   }
 
   if (!parts.length) return null;
 
   if (lastIndex < templateString.length) {
-    parts.push({
-      type: "literal",
-      value: templateString.slice(lastIndex),
-    });
+    parts.push(templateString.slice(lastIndex));
   }
 
-  return { targetNode, kind, attrName, parts };
+  // last: what the DOM currently holds (null = still the raw template)
+  return { targetNode, kind, attrName, parts, deps: [...deps], last: null };
 }
 
 function collectTemplateBindings() {
@@ -323,7 +386,9 @@ function collectTemplateBindings() {
   all.forEach((el) => {
     for (const attr of el.attributes) {
       if (attr.name === "fs-if") {
-        ifBindings.push({ el, expr: attr.value.trim() });
+        const deps = new Set();
+        const cond = compileCondition(attr.value, deps);
+        ifBindings.push({ el, cond, deps: [...deps], last: null });
         continue;
       }
 
@@ -336,20 +401,51 @@ function collectTemplateBindings() {
   });
 }
 
-function applyTemplateBindings(data) {
+function depsChanged(deps) {
+  for (const i of deps) {
+    if (depSlots[i].changed) return true;
+  }
+  return false;
+}
+
+// Apply bindings whose slots changed since the last frame; the DOM is only
+// written when a binding's output differs from what it holds
+let bindingsPrimed = false;
+
+function applyBindings(data) {
   if (!data) return;
+  if (!updateDepSlots(data) && bindingsPrimed) return;
+  bindingsPrimed = true;
+
+  const vals = depSlots.map((s) => s.value);
+
+  // First fs-if (visibility), then template bindings (text/attrs)
+  for (const b of ifBindings) {
+    if (b.last !== null && !depsChanged(b.deps)) continue;
+
+    const ok = b.cond(vals);
+    if (ok === b.last) continue;
+    b.last = ok;
+
+    if (!ok) {
+      // Hide and mark aria-hidden, but keep in DOM so we can re-show later
+      b.el.style.display = "none";
+      b.el.setAttribute("aria-hidden", "true");
+    } else {
+      b.el.style.display = "";
+      b.el.removeAttribute("aria-hidden");
+    }
+  }
 
   for (const b of templateBindings) {
-    let str = "";
+    if (b.last !== null && !depsChanged(b.deps)) continue;
 
+    let str = "";
     for (const part of b.parts) {
-      if (part.type === "literal") {
-        str += part.value;
-      } else {
-        const v = evaluateExpression(part.value, data);
-        str += v == null ? "" : String(v);
-      }
+      str += typeof part === "string" ? part : part(vals);
     }
+    if (str === b.last) continue;
+    b.last = str;
 
     if (b.kind === "text") {
       b.targetNode.nodeValue = str;
@@ -359,59 +455,145 @@ function applyTemplateBindings(data) {
   }
 }
 
-function applyIfBindings(data) {
-  if (!data) return;
+// -----------------------------------------------------------------------------
+// State + patches
+// -----------------------------------------------------------------------------
+let currentJsonState = null;
+let currentRev = 0;
 
-  for (const b of ifBindings) {
-    const ok = evaluateCondition(b.expr, data);
+function applyFullState(st) {
+  const rev = Number(st && st.rev) || 0;
+  if (rev && rev === currentRev && currentJsonState) return; // same version
 
-    if (!ok) {
-      // Hide and mark aria-hidden, but keep in DOM so we can re-show later
-      b.el.style.display = "none";
-      b.el.setAttribute("aria-hidden", "true");
-    } else {
-      b.el.style.display = "";
-      b.el.removeAttribute("aria-hidden");
+  currentJsonState = st;
+  currentRev = rev;
+  invalidateView();
+}
+
+function applyPatchOp(root, op) {
+  const keys = [];
+  const re = /([^[.\]]+)|\[(\d+)\]/g;
+  let m;
+  while ((m = re.exec(op.path)) !== null) {
+    keys.push(m[1] !== undefined ? m[1] : Number(m[2]));
+  }
+  if (!keys.length) return;
+
+  let cur = root;
+  for (let i = 0; i < keys.length - 1; i++) {
+    if (cur[keys[i]] == null) {
+      cur[keys[i]] = typeof keys[i + 1] === "number" ? [] : {};
     }
+    cur = cur[keys[i]];
   }
+
+  const last = keys[keys.length - 1];
+  if (op.op === "remove") {
+    delete cur[last];
+  } else {
+    cur[last] = op.value;
+  }
+}
+
+// Returns false if the patch doesn't start at our revision
+function applyPatch(msg) {
+  if (!currentJsonState || msg.from !== currentRev) return false;
+  if (msg.to === currentRev) return true; // nothing new (poll with since=)
+
+  for (const op of msg.ops || []) applyPatchOp(currentJsonState, op);
+  currentRev = msg.to;
+  currentJsonState.rev = msg.to;
+  invalidateView();
+  return true;
+}
+
+// A document from plugin.json/state is either a full state or a patch
+function applyStateDocument(doc) {
+  if (doc && Array.isArray(doc.ops)) {
+    if (!applyPatch(doc)) currentRev = 0; // next poll fetches everything
+    return;
+  }
+  applyFullState(doc);
+}
+
+// -----------------------------------------------------------------------------
+// Latency probe
+// -----------------------------------------------------------------------------
+// While the dock's probe runs, every saved version carries
+// probe = {seq, sent_ms, ack}. Once a new one has been applied, report it on
+// the next animation frame (when it is painted) so the plugin can build
+// per-transport latency percentiles.
+let probeAcked = 0;
+
+function ackProbe(via) {
+  const p = currentJsonState && currentJsonState.probe;
+  if (!p || !p.seq || !p.ack || p.seq === probeAcked) return;
+  probeAcked = p.seq;
+
+  const url = `${p.ack}?seq=${p.seq}&sent=${p.sent_ms}&via=${via}&applied=`;
+  requestAnimationFrame(() => {
+    fetch(url + Date.now(), { cache: "no-store" }).catch(() => {});
+  });
 }
 
 // -----------------------------------------------------------------------------
 // Rendering
 // -----------------------------------------------------------------------------
-let currentJsonState = null;
+// Two paths share one scheduler:
+//   - state path: a new version rebuilds the view model (buildView), without
+//     touching currentJsonState
+//   - clock path: between versions only the running timers and penalties are
+//     recomputed (updateClocks), and a render is only scheduled for the moment
+//     a displayed digit flips (or a frame-synced value arrives)
+// Nothing runs while the scoreboard is idle.
+let view = null;
+let viewDirty = true;
+let alarmThresholds = [];
+let renderQueued = false;
+let clockTimer = 0;
+
+function invalidateView() {
+  viewDirty = true;
+  requestRender();
+}
 
-function renderFrame() {
-  if (!currentJsonState) return;
+function requestRender() {
+  if (renderQueued) return;
+  renderQueued = true;
+  requestAnimationFrame(renderFrame);
+}
 
-  // Deep clone to avoid mutating original
-  const st = JSON.parse(JSON.stringify(currentJsonState));
+function scheduleClockTick(waitMs) {
+  if (clockTimer) clearTimeout(clockTimer);
+  clockTimer = 0;
+  if (!Number.isFinite(waitMs)) return;
 
-  // Ensure timers array
-  if (!Array.isArray(st.timers)) {
-    st.timers = [];
-  }
+  clockTimer = setTimeout(() => {
+    clockTimer = 0;
+    requestRender();
+  }, Math.max(1, Math.ceil(waitMs)));
+}
 
-  // Compute live timer values (mm:ss)
-  for (let i = 0; i < st.timers.length; i++) {
-    const t = st.timers[i] || {};
-    const ms = liveTimerMs(t);
-    t.live_ms = ms;
-    t.mmss = mmss(ms);
-    st.timers[i] = t;
-  }
+// Build derived view model:
+//   - team_x / team_y: left/right teams based on swap_sides
+//   - fields_xy: each custom field mapped to x/y based on swap_sides
+//   - timers: shallow copies that updateClocks() can annotate
+function buildView(st) {
+  const timers = Array.isArray(st.timers)
+    ? st.timers.map((t) => ({ ...(t || {}) }))
+    : [];
+
+  alarmThresholds =
+    st.alarms && Array.isArray(st.alarms.thresholds_ms)
+      ? st.alarms.thresholds_ms.filter((v) => v >= 0).sort((x, y) => x - y)
+      : [];
 
-  // ---------------------------------------------------------------------------
-  // Build derived view model:
-  //   - team_x / team_y: left/right teams based on swap_sides
-  //   - fields_xy: each custom field mapped to x/y based on swap_sides
-  // ---------------------------------------------------------------------------
   const baseHome = st.home || {};
   const baseAway = st.away || {};
   const swap = !!st.swap_sides;
 
-  const team_x = swap ? baseAway : baseHome; // left side
-  const team_y = swap ? baseHome : baseAway; // right side
+  const team_x = { ...(swap ? baseAway : baseHome) }; // left side
+  const team_y = { ...(swap ? baseHome : baseAway) }; // right side
 
   if (team_x.color) team_x.color = intToHex(team_x.color);
   if (team_y.color) team_y.color = intToHex(team_y.color);
@@ -428,40 +610,222 @@ function renderFrame() {
     })
     : [];
 
-  const view = {
+  return {
     ...st,
+    timers,
     team_x,
     team_y,
     fields_xy,
   };
+}
 
-  // First apply fs-if (visibility), then template bindings (text/attrs)
-  applyIfBindings(view);
-  applyTemplateBindings(view);
+// Time until mm:ss (or an alarm class) of a running timer changes
+function msUntilTimerFlip(t) {
+  const ms = t.live_ms;
+  if (t.mode === "countup") return 1000 - (ms % 1000);
+  if (ms <= 0) return Infinity;
+
+  // mm:ss floors: the text flips just below the next multiple of 1000
+  let wait = (ms % 1000) + 1;
+  for (const th of alarmThresholds) {
+    if (th < ms) wait = Math.min(wait, ms - th);
+  }
+  return wait;
+}
+
+// Active penalties per side (the plugin only ever sends running ones),
+// soonest expiry first. Templates have no arithmetic: summarize as "next to
+// expire" + "+N more".
+function penaltySummary(penalties, side) {
+  const list = penalties
+    .filter((p) => p && p.side === side)
+    .map((p) => {
+      const ms = liveTimerMs(p);
+      return { ...p, live_ms: ms, mmss: mmss(ms + 999) };
+    })
+    .filter((p) => p.live_ms > 0)
+    .sort((a, b) => a.live_ms - b.live_ms);
+
+  return {
+    active: list.length > 0,
+    mmss: list.length ? list[0].mmss : "",
+    more: list.length > 1 ? `+${list.length - 1}` : "",
+    list,
+  };
+}
+
+// Recompute clock values on the view (all of them after a rebuild, otherwise
+// only running ones). Returns ms until the next displayed change, or Infinity.
+function updateClocks(v, all) {
+  let next = Infinity;
+
+  // Frame-synced mode: OBS already computed the values for its video frames
+  const frame =
+    v.frame_clock && v.frame_clock.enabled &&
+    Array.isArray(frameTimers) && frameTimers.length === v.timers.length
+      ? frameTimers
+      : null;
+
+  for (let i = 0; i < v.timers.length; i++) {
+    const t = v.timers[i];
+    if (frame) {
+      t.live_ms = Number(frame[i].ms) || 0;
+      t.mmss = frame[i].text;
+    } else if (all || t.running) {
+      const ms = liveTimerMs(t);
+      t.live_ms = ms;
+      t.mmss = mmss(ms);
+      if (t.running && t.last_tick_ms && t.visible !== false) {
+        next = Math.min(next, msUntilTimerFlip(t));
+      }
+    } else {
+      continue;
+    }
+    t.alarm_class = alarmClass(t, alarmThresholds);
+  }
+
+  const penalties = Array.isArray(v.penalties) ? v.penalties : [];
+  if (all || penalties.some((p) => p && p.running)) {
+    const home = penaltySummary(penalties, "home");
+    const away = penaltySummary(penalties, "away");
+    v.penalty_x = v.swap_sides ? away : home;
+    v.penalty_y = v.swap_sides ? home : away;
+
+    for (const p of [...home.list, ...away.list]) {
+      // mmss(ms + 999) rounds up: flips at every multiple of 1000, down to 0
+      if (p.running && p.last_tick_ms) {
+        next = Math.min(next, ((p.live_ms + 999) % 1000) + 1);
+      }
+    }
+  }
+
+  return next;
+}
+
+function renderFrame() {
+  renderQueued = false;
+  if (!currentJsonState) return;
+
+  const rebuilt = viewDirty || !view;
+  if (rebuilt) {
+    view = buildView(currentJsonState);
+    viewDirty = false;
+  }
+
+  const next = updateClocks(view, rebuilt);
+  applyBindings(view);
+  scheduleClockTick(next);
+}
+
+// -----------------------------------------------------------------------------
+// Push channel (Server-Sent Events) with poll fallback
+// -----------------------------------------------------------------------------
+let pushActive = false;
+
+// Latest "frame" message: [{ms, text}] per timer, or null
+let frameTimers = null;
+
+// Re-request every image (a fresh URL bypasses the browser cache; the
+// server answers from its in-memory asset store)
+function reloadImages() {
+  const bust = "fsr=" + Date.now();
+  for (const img of document.images) {
+    const src = img.getAttribute("src");
+    if (!src) continue;
+    const base = src.replace(/[?&]fsr=\d+$/, "");
+    img.setAttribute("src", base + (base.includes("?") ? "&" : "?") + bust);
+  }
+}
+
+function startPush() {
+  // Only the plugin's localhost server speaks SSE; file:// keeps polling.
+  // ?transport=poll forces polling over HTTP too (e.g. to compare latencies).
+  const forcePoll =
+    new URLSearchParams(location.search).get("transport") === "poll";
+  if (
+    forcePoll ||
+    !("EventSource" in window) ||
+    !location.protocol.startsWith("http")
+  ) {
+    return;
+  }
+
+  const es = new EventSource("events");
+
+  es.addEventListener("state", (e) => {
+    try {
+      applyFullState(JSON.parse(e.data));
+      pushActive = true;
+      ackProbe("push");
+    } catch (err) {
+      // malformed message; wait for the next one
+    }
+  });
+
+  es.addEventListener("patch", (e) => {
+    let ok = false;
+    try {
+      ok = applyPatch(JSON.parse(e.data));
+    } catch (err) {
+      ok = false;
+    }
+    if (ok) {
+      ackProbe("push");
+    } else {
+      // Out of step: resync with a full fetch
+      currentRev = 0;
+      fetchState().then(applyStateDocument).catch(() => {});
+    }
+  });
+
+  // The plugin re-synced the Browser Source without reloading it (e.g. new
+  // resources folder): the full state came just before, images may differ
+  es.addEventListener("resync", () => {
+    reloadImages();
+  });
+
+  // Frame-aligned timer values from the plugin's OBS tick hook
+  es.addEventListener("frame", (e) => {
+    try {
+      frameTimers = JSON.parse(e.data).timers || null;
+    } catch (err) {
+      frameTimers = null;
+    }
+    requestRender();
+  });
+
+  // EventSource reconnects by itself; poll in the meantime
+  es.onerror = () => {
+    pushActive = false;
+    if (frameTimers) {
+      // Back to local clocks until frames flow again
+      frameTimers = null;
+      requestRender();
+    }
+  };
 }
 
 // -----------------------------------------------------------------------------
 // Poll loop
 // -----------------------------------------------------------------------------
 async function pollLoop() {
+  let delay = 1000;
   try {
-    const st = await fetchState();
-    currentJsonState = st;
+    if (!pushActive) {
+      applyStateDocument(await fetchState());
+      ackProbe(location.protocol.startsWith("http") ? "poll" : "file");
+    }
   } catch (e) {
-    // ignore; keep last state
+    // keep last state, but don't wait a whole cycle for the next attempt
+    delay = 250;
   } finally {
-    setTimeout(pollLoop, 1000);
+    setTimeout(pollLoop, delay);
   }
 }
 
-function animationLoop() {
-  renderFrame();
-  requestAnimationFrame(animationLoop);
-}
-
 // -----------------------------------------------------------------------------
 // Boot
 // -----------------------------------------------------------------------------
 collectTemplateBindings();
+startPush();
 pollLoop();
-animationLoop();
@@ -0,0 +1,113 @@
+#include "fly_score_actions.hpp"
+
+#include <array>
+
+namespace {
+
+struct IndexedSuffix {
+	const char *suffix;
+	FlyActionKind kind;
+};
+
+// Suffixes after "field_<n>_" / "timer_<n>_"
+constexpr std::array<IndexedSuffix, 5> kFieldSuffixes{{
+	{"toggle", FlyActionKind::FieldToggle},
+	{"home_inc", FlyActionKind::FieldHomeInc},
+	{"home_dec", FlyActionKind::FieldHomeDec},
+	{"away_inc", FlyActionKind::FieldAwayInc},
+	{"away_dec", FlyActionKind::FieldAwayDec},
+}};
+
+constexpr std::array<IndexedSuffix, 1> kTimerSuffixes{{
+	{"toggle", FlyActionKind::TimerToggle},
+}};
+
+// Parses "<n>_<suffix>" (the part after the prefix) against a suffix table.
+template<size_t N>
+FlyAction parse_indexed(const QString &rest, const std::array<IndexedSuffix, N> &table)
+{
+	const int sep = int(rest.indexOf(QLatin1Char('_')));
+	if (sep <= 0)
+		return {};
+
+	bool ok = false;
+	const int index = rest.left(sep).toInt(&ok);
+	if (!ok || index < 0)
+		return {};
+
+	const QString suffix = rest.mid(sep + 1);
+	for (const auto &e : table) {
+		if (suffix == QLatin1String(e.suffix))
+			return {e.kind, index};
+	}
+	return {};
+}
+
+struct NamedAction {
+	const char *id;
+	FlyActionKind kind;
+};
+
+// Actions without an index
+constexpr std::array<NamedAction, 6> kNamedActions{{
+	{"swap_sides", FlyActionKind::SwapSides},
+	{"toggle_scoreboard", FlyActionKind::ToggleScoreboard},
+	{"penalty_home_add", FlyActionKind::PenaltyHomeAdd},
+	{"penalty_home_remove", FlyActionKind::PenaltyHomeRemove},
+	{"penalty_away_add", FlyActionKind::PenaltyAwayAdd},
+	{"penalty_away_remove", FlyActionKind::PenaltyAwayRemove},
+}};
+
+} // namespace
+
+FlyAction fly_action_parse(const QString &id)
+{
+	for (const auto &e : kNamedActions) {
+		if (id == QLatin1String(e.id))
+			return {e.kind, -1};
+	}
+
+	if (id.startsWith(QLatin1String("field_")))
+		return parse_indexed(id.mid(6), kFieldSuffixes);
+	if (id.startsWith(QLatin1String("timer_")))
+		return parse_indexed(id.mid(6), kTimerSuffixes);
+
+	return {};
+}
+
+QString fly_action_id(const FlyAction &action)
+{
+	if (action.kind == FlyActionKind::TimerToggle)
+		return QStringLiteral("timer_%1_toggle").arg(action.index);
+
+	for (const auto &e : kNamedActions) {
+		if (e.kind == action.kind)
+			return QString::fromLatin1(e.id);
+	}
+
+	for (const auto &e : kFieldSuffixes) {
+		if (e.kind == action.kind)
+			return QStringLiteral("field_%1_%2").arg(action.index).arg(QLatin1String(e.suffix));
+	}
+	return {};
+}
+
+FlyActionGroup fly_action_group(FlyActionKind kind)
+{
+	switch (kind) {
+	case FlyActionKind::FieldToggle:
+	case FlyActionKind::FieldHomeInc:
+	case FlyActionKind::FieldHomeDec:
+	case FlyActionKind::FieldAwayInc:
+	case FlyActionKind::FieldAwayDec:
+		return FlyActionGroup::Fields;
+	case FlyActionKind::TimerToggle:
+	case FlyActionKind::PenaltyHomeAdd:
+	case FlyActionKind::PenaltyHomeRemove:
+	case FlyActionKind::PenaltyAwayAdd:
+	case FlyActionKind::PenaltyAwayRemove:
+		return FlyActionGroup::Timers;
+	default:
+		return FlyActionGroup::Scoreboard;
+	}
+}
@@ -0,0 +1,83 @@
+#include "fly_score_alarms.hpp"
+
+#include <algorithm>
+#include <functional>
+
+FlyAlarmScheduler::FlyAlarmScheduler(QObject *parent) : QObject(parent)
+{
+	timer_.setSingleShot(true);
+	timer_.setTimerType(Qt::PreciseTimer);
+	connect(&timer_, &QTimer::timeout, this, &FlyAlarmScheduler::onTimeout);
+}
+
+void FlyAlarmScheduler::setThresholds(const QVector<long long> &thresholdsMs)
+{
+	thresholds_.clear();
+	for (long long t : thresholdsMs) {
+		if (t >= 0 && !thresholds_.contains(t))
+			thresholds_.push_back(t);
+	}
+	std::sort(thresholds_.begin(), thresholds_.end(), std::greater<long long>());
+}
+
+void FlyAlarmScheduler::clear()
+{
+	pending_.clear();
+	timer_.stop();
+}
+
+void FlyAlarmScheduler::rearm(const QVector<FlyTimerEngine::Anchor> &anchors)
+{
+	pending_.clear();
+
+	const int64_t now = FlyTimerEngine::steadyNowMs();
+
+	for (int i = 0; i < anchors.size(); ++i) {
+		const FlyTimerEngine::Anchor &a = anchors[i];
+		if (!a.running || a.mode != FlyTimerMode::Countdown)
+			continue;
+
+		const int64_t value = FlyTimerEngine::valueAt(a, now);
+		for (long long t : thresholds_) {
+			// Only thresholds still ahead of the current value
+			if (value <= t)
+				continue;
+
+			// valueAt() == t exactly at this steady time
+			pending_.push_back({i, t, a.steadyAnchorMs + (a.valueMs - t)});
+		}
+	}
+
+	std::sort(pending_.begin(), pending_.end(),
+		  [](const Pending &x, const Pending &y) { return x.dueSteadyMs < y.dueSteadyMs; });
+
+	armNext();
+}
+
+void FlyAlarmScheduler::armNext()
+{
+	if (pending_.isEmpty()) {
+		timer_.stop();
+		return;
+	}
+
+	const int64_t wait = pending_.front().dueSteadyMs - FlyTimerEngine::steadyNowMs();
+	timer_.start(int(std::clamp<int64_t>(wait, 0, INT32_MAX)));
+}
+
+void FlyAlarmScheduler::onTimeout()
+{
+	const int64_t now = FlyTimerEngine::steadyNowMs();
+
+	// Detach everything that is due before emitting: handlers usually change the
+	// timers (auto-pause), which re-enters rearm().
+	QVector<Pending> due;
+	while (!pending_.isEmpty() && pending_.front().dueSteadyMs <= now) {
+		due.push_back(pending_.front());
+		pending_.pop_front();
+	}
+	armNext();
+
+	for (const Pending &p : due)
+		emit alarm(p.timer, p.thresholdMs, now - p.dueSteadyMs);
+}
@@ -0,0 +1,101 @@
+#include "fly_score_assets.hpp"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <cstddef>
+
+#ifdef ENABLE_EMBEDDED_DEFAULTS
+#include "embedded_assets.hpp"
+#endif
+
+static QByteArray make_etag(const QByteArray &data)
+{
+	return '"' + QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex().left(20) + '"';
+}
+
+#define FLY_EMBEDDED(id) make_embedded(fly_score_embedded::id, fly_score_embedded::id##_size)
+
+static FlyAsset make_embedded(const unsigned char *data, std::size_t size)
+{
+	FlyAsset a;
+	a.data = QByteArray(reinterpret_cast<const char *>(data), int(size));
+	a.etag = make_etag(a.data);
+	a.embedded = true;
+	return a;
+}
+
+bool fly_embedded_asset(const QString &name, FlyAsset &out)
+{
+#ifdef ENABLE_EMBEDDED_DEFAULTS
+	// Hashed once; the blobs never change for the lifetime of the plugin
+	static const QHash<QString, FlyAsset> table = []() {
+		QHash<QString, FlyAsset> t;
+#ifdef HAVE_index_html
+		t.insert(QStringLiteral("index.html"), FLY_EMBEDDED(index_html));
+#endif
+#ifdef HAVE_style_css
+		t.insert(QStringLiteral("style.css"), FLY_EMBEDDED(style_css));
+#endif
+#ifdef HAVE_script_js
+		t.insert(QStringLiteral("script.js"), FLY_EMBEDDED(script_js));
+#endif
+		return t;
+	}();
+
+	const auto it = table.constFind(name);
+	if (it == table.constEnd())
+		return false;
+	out = it.value();
+	return true;
+#else
+	Q_UNUSED(name);
+	Q_UNUSED(out);
+	return false;
+#endif
+}
+
+void FlyAssetStore::setRoot(const QString &docRoot)
+{
+	const QString abs = docRoot.isEmpty() ? QString() : QDir(docRoot).absolutePath();
+	if (abs == root_)
+		return;
+	root_ = abs;
+	files_.clear();
+}
+
+bool FlyAssetStore::lookup(const QString &relPath, FlyAsset &out)
+{
+	if (!root_.isEmpty()) {
+		// Resolve inside the resources folder only
+		const QString abs = QDir::cleanPath(root_ + relPath);
+		if (!abs.startsWith(root_ + QLatin1Char('/')))
+			return false;
+
+		const QFileInfo fi(abs);
+		if (fi.isFile()) {
+			CachedFile &c = files_[abs];
+			if (c.size != fi.size() || c.mtime != fi.lastModified()) {
+				QFile f(abs);
+				if (!f.open(QIODevice::ReadOnly)) {
+					files_.remove(abs);
+					return false;
+				}
+				c.asset.data = f.readAll();
+				c.asset.etag = make_etag(c.asset.data);
+				c.asset.embedded = false;
+				c.size = fi.size();
+				c.mtime = fi.lastModified();
+			}
+			out = c.asset;
+			return true;
+		}
+		files_.remove(abs);
+	}
+
+	// Only top-level names have embedded fallbacks
+	const QString name = relPath.startsWith(QLatin1Char('/')) ? relPath.mid(1) : relPath;
+	return fly_embedded_asset(name, out);
+}
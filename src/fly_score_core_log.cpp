@@ -0,0 +1,30 @@
+#include "fly_score_core_log.hpp"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+static void fly_stderr_log(int level, const char *msg)
+{
+	const char *tag = level <= LOG_ERROR ? "error" : level <= LOG_WARNING ? "warning" : "info";
+	std::fprintf(stderr, "%s: %s\n", tag, msg);
+}
+
+static std::atomic<FlyLogHandler> g_handler{&fly_stderr_log};
+
+void fly_core_set_log_handler(FlyLogHandler handler)
+{
+	g_handler.store(handler ? handler : &fly_stderr_log);
+}
+
+void fly_core_log(int level, const char *fmt, ...)
+{
+	char buf[1024];
+
+	va_list args;
+	va_start(args, fmt);
+	std::vsnprintf(buf, sizeof(buf), fmt, args);
+	va_end(args);
+
+	g_handler.load()(level, buf);
+}
@@ -14,6 +14,9 @@
 #include "fly_score_fields_dialog.hpp"
 #include "fly_score_timers_dialog.hpp"
 #include "fly_score_hotkeys_dialog.hpp"
+#include "fly_score_actions.hpp"
+#include "fly_score_fields_model.hpp"
+#include "fly_score_profiler.hpp"
 
 #include <obs.h>
 #ifdef ENABLE_FRONTEND_API
@@ -23,24 +26,32 @@
 #include <QAbstractButton>
 #include <QBoxLayout>
 #include <QCheckBox>
+#include <QDateTime>
 #include <QDir>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QFontDatabase>
 #include <QDesktopServices>
 #include <QUrl>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QHash>
+#include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMessageBox>
 #include <QPushButton>
 #include <QShortcut>
+#include <QSet>
+#include <QSignalBlocker>
 #include <QSizePolicy>
 #include <QSpinBox>
 #include <QSpacerItem>
+#include <QTableView>
+#include <QTimer>
 
 #include <algorithm>
+#include <array>
 
 FlyScoreDock::FlyScoreDock(QWidget *parent) : QWidget(parent)
 {
@@ -48,6 +59,38 @@ FlyScoreDock::FlyScoreDock(QWidget *parent) : QWidget(parent)
 	sp.setHorizontalPolicy(QSizePolicy::Preferred);
 	sp.setVerticalPolicy(QSizePolicy::Expanding);
 	setSizePolicy(sp);
+
+	// Only armed while at least one timer runs (see updateTimerTickDriver)
+	timerTick_ = new QTimer(this);
+	timerTick_->setTimerType(Qt::CoarseTimer);
+	timerTick_->setInterval(kDockTimerTickMs);
+	connect(timerTick_, &QTimer::timeout, this, &FlyScoreDock::onTimerTick);
+
+	// Drives penalty expiry at the wheel's resolution; armed only while needed
+	penaltyTick_ = new QTimer(this);
+	penaltyTick_->setTimerType(Qt::PreciseTimer);
+	penaltyTick_->setInterval(int(penalties_.tickMs()));
+	connect(penaltyTick_, &QTimer::timeout, this, &FlyScoreDock::onPenaltyTick);
+
+	alarms_ = new FlyAlarmScheduler(this);
+	connect(alarms_, &FlyAlarmScheduler::alarm, this, &FlyScoreDock::onTimerAlarm);
+
+	// Diagnostics card refresh; armed only while the card is expanded
+	diagTick_ = new QTimer(this);
+	diagTick_->setTimerType(Qt::CoarseTimer);
+	diagTick_->setInterval(kDiagnosticsRefreshMs);
+	connect(diagTick_, &QTimer::timeout, this, &FlyScoreDock::refreshDiagnostics);
+
+	diagLogTick_ = new QTimer(this);
+	diagLogTick_->setTimerType(Qt::VeryCoarseTimer);
+	diagLogTick_->setInterval(kDiagnosticsLogMs);
+	connect(diagLogTick_, &QTimer::timeout, this, &FlyScoreDock::logDiagnostics);
+}
+
+FlyScoreDock::~FlyScoreDock()
+{
+	// Make sure the last snapshot reaches disk before the worker goes away
+	persist_.flush();
 }
 
 // ------------------------------------------------------------
@@ -81,6 +124,11 @@ QList<FlyHotkeyBinding> FlyScoreDock::buildDefaultHotkeyBindings() const
 		v.push_back({baseId + "_toggle", tr("Timer: %1 - Start/Pause").arg(label), QKeySequence()});
 	}
 
+	v.push_back({"penalty_home_add", tr("Penalty: Home - Add"), QKeySequence()});
+	v.push_back({"penalty_home_remove", tr("Penalty: Home - Remove next"), QKeySequence()});
+	v.push_back({"penalty_away_add", tr("Penalty: Guests - Add"), QKeySequence()});
+	v.push_back({"penalty_away_remove", tr("Penalty: Guests - Remove next"), QKeySequence()});
+
 	return v;
 }
 
@@ -104,80 +152,116 @@ QList<FlyHotkeyBinding> FlyScoreDock::buildMergedHotkeyBindings() const
 	return merged;
 }
 
-void FlyScoreDock::clearAllShortcuts()
+// Flat dispatch table, indexed by FlyActionKind. Shortcuts, macros and any
+// remote trigger all end up here with an already-parsed action.
+using FlyActionHandler = void (*)(FlyScoreDock &, int);
+using FlyActionTable = std::array<FlyActionHandler, size_t(FlyActionKind::Count)>;
+
+// Slots are assigned by kind, so reordering FlyActionKind cannot shift them
+static constexpr FlyActionTable make_action_table()
 {
-	for (auto *sc : shortcuts_) {
-		if (sc)
-			sc->deleteLater();
+	FlyActionTable t{};
+	auto set = [&t](FlyActionKind kind, FlyActionHandler fn) { t[size_t(kind)] = fn; };
+
+	set(FlyActionKind::SwapSides, [](FlyScoreDock &d, int) { d.toggleSwap(); });
+	set(FlyActionKind::ToggleScoreboard, [](FlyScoreDock &d, int) { d.toggleScoreboardVisible(); });
+	set(FlyActionKind::FieldToggle, [](FlyScoreDock &d, int i) { d.toggleCustomFieldVisible(i); });
+	set(FlyActionKind::FieldHomeInc, [](FlyScoreDock &d, int i) { d.bumpCustomFieldHome(i, +1); });
+	set(FlyActionKind::FieldHomeDec, [](FlyScoreDock &d, int i) { d.bumpCustomFieldHome(i, -1); });
+	set(FlyActionKind::FieldAwayInc, [](FlyScoreDock &d, int i) { d.bumpCustomFieldAway(i, +1); });
+	set(FlyActionKind::FieldAwayDec, [](FlyScoreDock &d, int i) { d.bumpCustomFieldAway(i, -1); });
+	set(FlyActionKind::TimerToggle, [](FlyScoreDock &d, int i) { d.toggleTimerRunning(i); });
+	set(FlyActionKind::PenaltyHomeAdd, [](FlyScoreDock &d, int) { d.addPenalty(FlyFieldSide::Home); });
+	set(FlyActionKind::PenaltyHomeRemove, [](FlyScoreDock &d, int) { d.removePenalty(FlyFieldSide::Home); });
+	set(FlyActionKind::PenaltyAwayAdd, [](FlyScoreDock &d, int) { d.addPenalty(FlyFieldSide::Away); });
+	set(FlyActionKind::PenaltyAwayRemove, [](FlyScoreDock &d, int) { d.removePenalty(FlyFieldSide::Away); });
+	return t;
+}
+
+static constexpr FlyActionTable kActionTable = make_action_table();
+
+static_assert(
+	[] {
+		for (size_t i = size_t(FlyActionKind::None) + 1; i < kActionTable.size(); ++i) {
+			if (!kActionTable[i])
+				return false;
+		}
+		return true;
+	}(),
+	"every FlyActionKind needs a handler in make_action_table()");
+
+void FlyScoreDock::triggerAction(const FlyAction &action)
+{
+	const auto slot = size_t(action.kind);
+	if (slot >= kActionTable.size() || !kActionTable[slot])
+		return;
+
+	// Whatever the action saves carries this as the origin of its
+	// hotkey-to-disk latency
+	pendingActionUs_ = FlyStatePersister::nowUs();
+	kActionTable[slot](*this, action.index);
+	pendingActionUs_ = 0;
+}
+
+static bool same_bindings(const QList<FlyHotkeyBinding> &a, const QList<FlyHotkeyBinding> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (int i = 0; i < a.size(); ++i) {
+		if (a[i].actionId != b[i].actionId || a[i].sequence != b[i].sequence || a[i].label != b[i].label)
+			return false;
 	}
-	shortcuts_.clear();
+	return true;
 }
 
 void FlyScoreDock::applyHotkeyBindings(const QList<FlyHotkeyBinding> &bindings)
 {
-	clearAllShortcuts();
+	FLY_PROFILE_SCOPE("FlyScoreDock::applyHotkeyBindings");
+
+	const bool changed = !same_bindings(hotkeyBindings_, bindings);
 	hotkeyBindings_ = bindings;
 
 	// Persist in separate file (existing helper)
-	fly_hotkeys_save(dataDir_, hotkeyBindings_);
+	if (changed)
+		fly_hotkeys_save(dataDir_, hotkeyBindings_);
+
+	// Incremental rebind: an action ID always parses to the same action, so an
+	// existing shortcut only needs its key updated. Only added/removed bindings
+	// create or delete QShortcut objects.
+	QSet<QString> wanted;
+	wanted.reserve(bindings.size());
 
 	for (const auto &b : bindings) {
 		if (b.sequence.isEmpty())
 			continue;
 
+		const FlyAction action = fly_action_parse(b.actionId);
+		if (!action.isValid())
+			continue;
+
+		wanted.insert(b.actionId);
+
+		if (QShortcut *sc = shortcuts_.value(b.actionId)) {
+			if (sc->key() != b.sequence)
+				sc->setKey(b.sequence);
+			continue;
+		}
+
 		auto *sc = new QShortcut(b.sequence, this);
 		sc->setContext(Qt::ApplicationShortcut);
-		shortcuts_.push_back(sc);
-
-		const QString &id = b.actionId;
-
-		if (id == QLatin1String("swap_sides")) {
-			connect(sc, &QShortcut::activated, this, [this]() { toggleSwap(); });
-		} else if (id == QLatin1String("toggle_scoreboard")) {
-			connect(sc, &QShortcut::activated, this, [this]() { toggleScoreboardVisible(); });
-
-		} else if (id.startsWith(QLatin1String("field_"))) {
-			const auto parts = id.split(QLatin1Char('_'));
-			if (parts.size() < 3)
-				continue;
-
-			bool ok = false;
-			int idx = parts[1].toInt(&ok);
-			if (!ok)
-				continue;
-
-			if (parts.size() == 3 && parts[2] == QLatin1String("toggle")) {
-				connect(sc, &QShortcut::activated, this,
-					[this, idx]() { toggleCustomFieldVisible(idx); });
-			} else if (parts.size() == 4) {
-				const QString side = parts[2];
-				const QString dir = parts[3];
-
-				if (side == QLatin1String("home") && dir == QLatin1String("inc"))
-					connect(sc, &QShortcut::activated, this,
-						[this, idx]() { bumpCustomFieldHome(idx, +1); });
-				else if (side == QLatin1String("home") && dir == QLatin1String("dec"))
-					connect(sc, &QShortcut::activated, this,
-						[this, idx]() { bumpCustomFieldHome(idx, -1); });
-				else if (side == QLatin1String("away") && dir == QLatin1String("inc"))
-					connect(sc, &QShortcut::activated, this,
-						[this, idx]() { bumpCustomFieldAway(idx, +1); });
-				else if (side == QLatin1String("away") && dir == QLatin1String("dec"))
-					connect(sc, &QShortcut::activated, this,
-						[this, idx]() { bumpCustomFieldAway(idx, -1); });
-			}
-
-		} else if (id.startsWith(QLatin1String("timer_"))) {
-			const auto parts = id.split(QLatin1Char('_'));
-			if (parts.size() == 3 && parts[2] == QLatin1String("toggle")) {
-				bool ok = false;
-				int idx = parts[1].toInt(&ok);
-				if (!ok)
-					continue;
+		connect(sc, &QShortcut::activated, this, [this, action]() { triggerAction(action); });
+		shortcuts_.insert(b.actionId, sc);
+	}
 
-				connect(sc, &QShortcut::activated, this, [this, idx]() { toggleTimerRunning(idx); });
-			}
+	for (auto it = shortcuts_.begin(); it != shortcuts_.end();) {
+		if (wanted.contains(it.key())) {
+			++it;
+			continue;
 		}
+		if (it.value())
+			it.value()->deleteLater();
+		it = shortcuts_.erase(it);
 	}
 }
 
@@ -202,12 +286,15 @@ void FlyScoreDock::openHotkeysDialog()
 bool FlyScoreDock::init()
 {
 	dataDir_ = fly_get_data_root();
+	nativeBoard_.setDocRoot(dataDir_);
 
 	loadState();
 	ensureResourcesDefaults();
 
 	hotkeyBindings_ = fly_hotkeys_load(dataDir_);
 
+	startOverlayServer();
+
 	setObjectName(QStringLiteral("FlyScoreDock"));
 	setAttribute(Qt::WA_StyledBackground, true);
 	setStyleSheet(QStringLiteral("FlyScoreDock { background: rgba(39, 42, 51, 1.0)}"));
@@ -305,11 +392,31 @@ bool FlyScoreDock::init()
 	customFieldsLayout_->setSpacing(4);
 	mainVBox->addLayout(customFieldsLayout_);
 
-	// Divider label for timers
+	// Divider label for timers (+ frame clock toggle)
 	{
+		auto *row = new QHBoxLayout();
+		row->setContentsMargins(0, 0, 0, 0);
+
 		auto *lbl = new QLabel(QStringLiteral("Timers"), mainBox);
 		lbl->setStyleSheet(QStringLiteral("font-weight:600; margin-top:6px;"));
-		mainVBox->addWidget(lbl);
+		row->addWidget(lbl);
+		row->addStretch(1);
+
+		frameClockCheck_ = new QCheckBox(QStringLiteral("Frame-synced"), mainBox);
+		frameClockCheck_->setToolTip(
+			QStringLiteral("Publish timer values aligned to OBS video frames (tenths below one minute)"));
+		frameClockCheck_->setChecked(st_.frame_clock.enabled);
+		row->addWidget(frameClockCheck_);
+
+		mainVBox->addLayout(row);
+
+		connect(frameClockCheck_, &QCheckBox::toggled, this, [this](bool on) {
+			if (st_.frame_clock.enabled == on)
+				return;
+			st_.frame_clock.enabled = on;
+			applyFrameClock();
+			saveState();
+		});
 	}
 
 	// Timers quick controls
@@ -318,6 +425,47 @@ bool FlyScoreDock::init()
 	timersLayout_->setSpacing(4);
 	mainVBox->addLayout(timersLayout_);
 
+	// Penalties quick controls (they run with the first timer)
+	{
+		auto *row = new QHBoxLayout();
+		row->setContentsMargins(0, 0, 0, 0);
+		row->setSpacing(6);
+
+		auto *lbl = new QLabel(QStringLiteral("Penalties"), mainBox);
+		lbl->setMinimumWidth(120);
+		row->addWidget(lbl);
+
+		penaltiesLbl_ = new QLabel(mainBox);
+		penaltiesLbl_->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+		row->addWidget(penaltiesLbl_, 1);
+
+		auto makeBtn = [mainBox](const QString &text, const QString &tooltip) {
+			auto *btn = new QPushButton(text, mainBox);
+			btn->setToolTip(tooltip);
+			btn->setCursor(Qt::PointingHandCursor);
+			btn->setMaximumWidth(60);
+			return btn;
+		};
+
+		auto *homeAdd = makeBtn(QStringLiteral("H +"), QStringLiteral("Add a home penalty"));
+		auto *homeRemove = makeBtn(QStringLiteral("H −"), QStringLiteral("Remove the next home penalty"));
+		auto *awayAdd = makeBtn(QStringLiteral("G +"), QStringLiteral("Add a guests penalty"));
+		auto *awayRemove = makeBtn(QStringLiteral("G −"), QStringLiteral("Remove the next guests penalty"));
+
+		row->addWidget(homeAdd);
+		row->addWidget(homeRemove);
+		row->addWidget(awayAdd);
+		row->addWidget(awayRemove);
+		mainVBox->addLayout(row);
+
+		connect(homeAdd, &QPushButton::clicked, this, [this]() { addPenalty(FlyFieldSide::Home); });
+		connect(homeRemove, &QPushButton::clicked, this, [this]() { removePenalty(FlyFieldSide::Home); });
+		connect(awayAdd, &QPushButton::clicked, this, [this]() { addPenalty(FlyFieldSide::Away); });
+		connect(awayRemove, &QPushButton::clicked, this, [this]() { removePenalty(FlyFieldSide::Away); });
+
+		refreshPenaltiesLabel();
+	}
+
 	mainBox->setLayout(mainVBox);
 	root->addWidget(mainBox);
 
@@ -334,6 +482,10 @@ bool FlyScoreDock::init()
 	addOrUpdateBtn->setCursor(Qt::PointingHandCursor);
 	addOrUpdateBtn->setToolTip(QStringLiteral("Add or update browser source in current scene"));
 
+	auto *addNativeBtn = new QPushButton(QStringLiteral("🖼️"), content);
+	addNativeBtn->setCursor(Qt::PointingHandCursor);
+	addNativeBtn->setToolTip(QStringLiteral("Add native scoreboard source (no browser) to current scene"));
+
 	auto *clearBtn = new QPushButton(QStringLiteral("🧹"), content);
 	clearBtn->setCursor(Qt::PointingHandCursor);
 	clearBtn->setToolTip(QStringLiteral("Reset stats and timers (keep teams & logos)"));
@@ -351,6 +503,7 @@ bool FlyScoreDock::init()
 	hotkeysBtn->setToolTip(QStringLiteral("Configure hotkeys"));
 
 	bottomRow->addWidget(addOrUpdateBtn);
+	bottomRow->addWidget(addNativeBtn);
 	bottomRow->addWidget(clearBtn);
 	bottomRow->addWidget(setResourcesPathBtn_);
 	bottomRow->addWidget(openResourcesFolderBtn_);
@@ -358,6 +511,48 @@ bool FlyScoreDock::init()
 	bottomRow->addWidget(hotkeysBtn);
 
 	root->addLayout(bottomRow);
+
+	// ---------------------------------------------------------------------
+	// Diagnostics (collapsed by default; refreshed only while expanded)
+	// ---------------------------------------------------------------------
+	{
+		auto *diagBox = new QGroupBox(QStringLiteral("Diagnostics"), content);
+		diagBox->setStyleSheet(cardStyle);
+		diagBox->setCheckable(true);
+		diagBox->setChecked(false);
+
+		auto *diagVBox = new QVBoxLayout(diagBox);
+		diagVBox->setContentsMargins(8, 8, 8, 8);
+
+		diagLbl_ = new QLabel(diagBox);
+		diagLbl_->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+		diagLbl_->setTextInteractionFlags(Qt::TextSelectableByMouse);
+		diagLbl_->setVisible(false);
+		diagVBox->addWidget(diagLbl_);
+
+		auto *probeCheck = new QCheckBox(QStringLiteral("Latency probe"), diagBox);
+		probeCheck->setToolTip(QStringLiteral(
+			"Stamp every change and have the overlay report when it reached the screen (p50/p95/p99 per transport)"));
+		probeCheck->setVisible(false);
+		diagVBox->addWidget(probeCheck);
+
+		root->addWidget(diagBox);
+
+		connect(probeCheck, &QCheckBox::toggled, this, &FlyScoreDock::setLatencyProbe);
+
+		connect(diagBox, &QGroupBox::toggled, this, [this, probeCheck](bool on) {
+			diagLbl_->setVisible(on);
+			probeCheck->setVisible(on);
+			if (on) {
+				diagUiSince_ = diagSample();
+				refreshDiagnostics();
+				diagTick_->start();
+			} else {
+				diagTick_->stop();
+			}
+		});
+	}
+
 	root->addStretch(1);
 
 	// ---------------------------------------------------------------------
@@ -374,6 +569,7 @@ bool FlyScoreDock::init()
 	});
 
 	connect(addOrUpdateBtn, &QPushButton::clicked, this, [this]() { updateBrowserSourceToCurrentResources(); });
+	connect(addNativeBtn, &QPushButton::clicked, this, []() { fly_ensure_native_source_in_current_scene(); });
 
 	connect(clearBtn, &QPushButton::clicked, this, &FlyScoreDock::onClearTeamsAndReset);
 
@@ -391,8 +587,10 @@ bool FlyScoreDock::init()
 	// ---------------------------------------------------------------------
 	refreshUiFromState(false);
 
-	hotkeyBindings_ = buildMergedHotkeyBindings();
-	applyHotkeyBindings(hotkeyBindings_);
+	applyHotkeyBindings(buildMergedHotkeyBindings());
+
+	diagLogSince_ = diagSample();
+	diagLogTick_->start();
 
 	return true;
 }
@@ -411,18 +609,33 @@ void FlyScoreDock::updateBrowserSourceToCurrentResources()
 
 	const QString indexPath = QDir(overlayRoot).filePath(QStringLiteral("index.html"));
 
-	// Ensure JSON exists and is current so overlay reads immediately
-	fly_state_ensure_json_exists(overlayRoot, &st_);
-	fly_state_save(overlayRoot, st_);
+	// Write the current state (after anything still queued) so the overlay reads it immediately
+	persist_.submit(overlayRoot, st_);
+	persist_.flush();
+
+	// Prefer the localhost server (state + embedded assets from memory); fall back to the local file
+	const QString target = server_.isRunning() ? server_.overlayUrl() : indexPath;
 
-	if (!QFileInfo::exists(indexPath)) {
+	if (!server_.isRunning() && !QFileInfo::exists(indexPath)) {
 		LOGW("index.html not found in resources folder: %s", indexPath.toUtf8().constData());
 	}
 
-	// Must update existing source or create if missing
-	fly_ensure_browser_source_in_current_scene(indexPath);
+	// Must update existing source or create if missing. When its settings did not
+	// change, the page keeps running and only needs the new data.
+	if (fly_ensure_browser_source_in_current_scene(target, st_.browser) == FlyBrowserSync::Unchanged)
+		server_.resync();
 
-	LOGI("Browser source synced to: %s", indexPath.toUtf8().constData());
+	LOGI("Browser source synced to: %s", target.toUtf8().constData());
+}
+
+void FlyScoreDock::startOverlayServer()
+{
+	server_.stop();
+
+	if (st_.server.enabled && !server_.start(dataDir_, static_cast<quint16>(st_.server.port)))
+		LOGW("Overlay server unavailable; Browser Source will read files from disk");
+
+	server_.publish(st_);
 }
 
 void FlyScoreDock::onSetResourcesPath()
@@ -432,11 +645,14 @@ void FlyScoreDock::onSetResourcesPath()
 	if (picked.isEmpty())
 		return;
 
+	// Anything still queued belongs to the old folder
+	persist_.flush();
+
 	fly_set_data_root(picked);
 	dataDir_ = fly_get_data_root_no_ui();
-
-	fly_state_ensure_json_exists(dataDir_, &st_);
-	fly_state_save(dataDir_, st_);
+	server_.setDocRoot(dataDir_);
+	nativeBoard_.setDocRoot(dataDir_);
+	nativeBoard_.publish(st_, timerEngine_.anchors());
 
 	// IMPORTANT: update browser source with new path
 	updateBrowserSourceToCurrentResources();
@@ -465,26 +681,55 @@ void FlyScoreDock::loadState()
 	if (st_.timers.isEmpty()) {
 		FlyTimer main;
 		main.label = QStringLiteral("First Half");
-		main.mode = QStringLiteral("countdown");
+		main.mode = FlyTimerMode::Countdown;
 		main.running = false;
 		main.initial_ms = 0;
 		main.remaining_ms = 0;
 		main.last_tick_ms = 0;
 		st_.timers.push_back(main);
 		fly_state_save(dataDir_, st_);
-	} else if (st_.timers[0].mode.isEmpty()) {
-		st_.timers[0].mode = QStringLiteral("countdown");
 	}
+
+	// The engine owns the timers from here on; st_.timers is its published snapshot
+	timerEngine_.load(st_.timers);
+	st_.timers = timerEngine_.snapshot();
+	updateTimerTickDriver();
+
+	alarms_->setThresholds(st_.alarms.thresholds_ms);
+	alarms_->rearm(timerEngine_.anchors());
+
+	penalties_.load(st_.penalties, timerEngine_.isRunning(0));
+	st_.penalties = penalties_.snapshot();
+	updatePenaltyTickDriver();
+	refreshPenaltiesLabel();
+
+	applyFrameClock();
+
+	server_.publish(st_);
+	nativeBoard_.publish(st_, timerEngine_.anchors());
 }
 
 void FlyScoreDock::saveState()
 {
-	fly_state_save(dataDir_, st_);
+	FLY_PROFILE_SCOPE("FlyScoreDock::saveState");
+	++saveCount_;
+
+	if (probeEnabled_) {
+		++st_.probe.seq;
+		st_.probe.sent_ms = QDateTime::currentMSecsSinceEpoch();
+		st_.probe.ack = server_.probeAckUrl();
+	}
+
+	// Snapshot only; serialization and the disk write happen on the persist worker
+	persist_.submit(dataDir_, st_, pendingActionUs_);
+	server_.publish(st_);
+	nativeBoard_.publish(st_, timerEngine_.anchors());
 }
 
 void FlyScoreDock::refreshUiFromState(bool onlyTimeIfRunning)
 {
 	Q_UNUSED(onlyTimeIfRunning);
+	FLY_PROFILE_SCOPE("FlyScoreDock::refreshUiFromState");
 
 	if (swapSides_ && swapSides_->isChecked() != st_.swap_sides)
 		swapSides_->setChecked(st_.swap_sides);
@@ -509,46 +754,92 @@ void FlyScoreDock::onClearTeamsAndReset()
 		cf.away = 0;
 	}
 
-	for (auto &tm : st_.timers) {
-		qint64 ms = tm.initial_ms;
-		if (ms < 0)
-			ms = 0;
-		tm.remaining_ms = ms;
-		tm.running = false;
-		tm.last_tick_ms = 0;
-	}
+	timerEngine_.resetAll();
+	st_.timers = timerEngine_.snapshot();
+	updateTimerTickDriver();
+	if (frameClock_.isRunning())
+		frameClock_.setTimers(timerEngine_.anchors());
+	alarms_->rearm(timerEngine_.anchors());
+
+	penalties_.load({}, false);
+	st_.penalties.clear();
+	updatePenaltyTickDriver();
+	refreshPenaltiesLabel();
 
 	saveState();
 	refreshUiFromState(false);
 }
 
 // ------------------------------------------------------------
-// Custom fields quick controls (same logic you already had)
+// Custom fields quick controls
 // ------------------------------------------------------------
 
-void FlyScoreDock::clearAllCustomFieldRows()
+void FlyScoreDock::trimCustomFieldRows(int count)
 {
-	customFields_.clear();
-	if (!customFieldsLayout_)
+	while (customFields_.size() > count) {
+		FlyCustomFieldUi ui = customFields_.takeLast();
+		if (customFieldsLayout_ && ui.row)
+			customFieldsLayout_->removeWidget(ui.row);
+		if (ui.row)
+			ui.row->deleteLater();
+	}
+}
+
+void FlyScoreDock::ensureCustomFieldsTable()
+{
+	if (fieldsView_)
 		return;
 
-	while (QLayoutItem *item = customFieldsLayout_->takeAt(0)) {
-		if (QWidget *w = item->widget())
-			w->deleteLater();
-		delete item;
-	}
+	fieldsModel_ = new FlyCustomFieldsModel(&st_, this);
+
+	fieldsView_ = new QTableView(this);
+	fieldsView_->setModel(fieldsModel_);
+	fieldsView_->setItemDelegate(new FlyCustomFieldsDelegate(fieldsView_));
+	fieldsView_->setSelectionMode(QAbstractItemView::NoSelection);
+	fieldsView_->setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed);
+	fieldsView_->setMinimumHeight(240);
+
+	// Fixed sizes only: ResizeToContents would measure every row
+	fieldsView_->verticalHeader()->hide();
+	fieldsView_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+	fieldsView_->verticalHeader()->setDefaultSectionSize(28);
+
+	auto *hh = fieldsView_->horizontalHeader();
+	hh->setSectionResizeMode(QHeaderView::Fixed);
+	hh->setSectionResizeMode(FlyCustomFieldsModel::ColLabel, QHeaderView::Stretch);
+	hh->resizeSection(FlyCustomFieldsModel::ColVisible, 28);
+	hh->resizeSection(FlyCustomFieldsModel::ColHome, 120);
+	hh->resizeSection(FlyCustomFieldsModel::ColAway, 120);
+
+	customFieldsLayout_->addWidget(fieldsView_);
+
+	connect(fieldsModel_, &FlyCustomFieldsModel::fieldEdited, this, [this](int) { saveState(); });
 }
 
 void FlyScoreDock::loadCustomFieldControlsFromState()
 {
-	clearAllCustomFieldRows();
 	if (!customFieldsLayout_)
 		return;
 
-	customFields_.reserve(st_.custom_fields.size());
+	// Large stat tables: one model/view, cost follows visible rows, not field count
+	if (st_.custom_fields.size() > kFieldsTableThreshold) {
+		trimCustomFieldRows(0);
+		if (customFieldsHeader_)
+			customFieldsHeader_->hide();
 
-	// header
-	{
+		ensureCustomFieldsTable();
+		fieldsView_->show();
+		fieldsModel_->reload();
+		return;
+	}
+
+	if (fieldsView_)
+		fieldsView_->hide();
+	if (customFieldsHeader_)
+		customFieldsHeader_->show();
+
+	// header (built once)
+	if (!customFieldsHeader_) {
 		auto *hdrRow = new QWidget(this);
 		auto *grid = new QGridLayout(hdrRow);
 		grid->setContentsMargins(0, 0, 0, 0);
@@ -577,295 +868,340 @@ void FlyScoreDock::loadCustomFieldControlsFromState()
 		grid->setColumnStretch(3, 1);
 
 		customFieldsLayout_->addWidget(hdrRow);
+		customFieldsHeader_ = hdrRow;
 	}
 
-	for (int i = 0; i < st_.custom_fields.size(); ++i) {
-		const auto &cf = st_.custom_fields[i];
-		FlyCustomFieldUi ui;
-
-		auto *row = new QWidget(this);
-		auto *grid = new QGridLayout(row);
-		grid->setContentsMargins(0, 0, 0, 0);
-		grid->setHorizontalSpacing(6);
-		grid->setVerticalSpacing(0);
-
-		auto *visibleCheck = new QCheckBox(row);
-		visibleCheck->setChecked(cf.visible);
-		grid->addWidget(visibleCheck, 0, 0, Qt::AlignLeft | Qt::AlignVCenter);
+	// Reconcile row count, then push values into the rows we keep
+	const int n = st_.custom_fields.size();
+	trimCustomFieldRows(n);
+	while (customFields_.size() < n)
+		customFields_.push_back(createCustomFieldRow(customFields_.size()));
 
-		auto *labelLbl = new QLabel(cf.label.isEmpty() ? QStringLiteral("(unnamed)") : cf.label, row);
-		labelLbl->setMinimumWidth(120);
-		grid->addWidget(labelLbl, 0, 1);
-
-		auto makeEmojiBtn = [](const QString &emoji, const QString &tooltip, QWidget *parent) {
-			auto *btn = new QPushButton(parent);
-			btn->setText(emoji);
-			btn->setToolTip(tooltip);
-			btn->setCursor(Qt::PointingHandCursor);
-			btn->setStyleSheet(
-				"QPushButton {"
-				"  font-family:'Segoe UI Emoji','Noto Color Emoji','Apple Color Emoji',sans-serif;"
-				"  font-size:8px;"
-				"  padding:0;"
-				"}");
-			return btn;
-		};
+	for (int i = 0; i < n; ++i)
+		updateCustomFieldRow(customFields_[i], st_.custom_fields[i]);
+}
 
-		auto *homeSpin = new QSpinBox(row);
-		homeSpin->setRange(0, 999);
-		homeSpin->setValue(std::max(0, cf.home));
-		homeSpin->setMaximumWidth(60);
-		homeSpin->setMaximumHeight(32);
-		homeSpin->setButtonSymbols(QAbstractSpinBox::NoButtons);
-
-		auto *minusHome = makeEmojiBtn(QStringLiteral("➖"), QStringLiteral("Home -1"), row);
-		auto *plusHome = makeEmojiBtn(QStringLiteral("➕"), QStringLiteral("Home +1"), row);
-
-		auto *awaySpin = new QSpinBox(row);
-		awaySpin->setRange(0, 999);
-		awaySpin->setValue(std::max(0, cf.away));
-		awaySpin->setMaximumWidth(60);
-		awaySpin->setMaximumHeight(32);
-		awaySpin->setButtonSymbols(QAbstractSpinBox::NoButtons);
-
-		auto *minusAway = makeEmojiBtn(QStringLiteral("➖"), QStringLiteral("Guests -1"), row);
-		auto *plusAway = makeEmojiBtn(QStringLiteral("➕"), QStringLiteral("Guests +1"), row);
-
-		//const int h = homeSpin->sizeHint().height();
-		minusHome->setFixedSize(32, 32);
-		plusHome->setFixedSize(32, 32);
-		minusAway->setFixedSize(32, 32);
-		plusAway->setFixedSize(32, 32);
-
-		auto *homeBox = new QWidget(row);
-		auto *homeLay = new QHBoxLayout(homeBox);
-		homeLay->setContentsMargins(0, 0, 0, 0);
-		homeLay->setSpacing(4);
-		homeLay->addWidget(minusHome, 0, Qt::AlignHCenter | Qt::AlignVCenter);
-		homeLay->addWidget(homeSpin, 0, Qt::AlignHCenter | Qt::AlignVCenter);
-		homeLay->addWidget(plusHome, 0, Qt::AlignHCenter | Qt::AlignVCenter);
-
-		auto *awayBox = new QWidget(row);
-		auto *awayLay = new QHBoxLayout(awayBox);
-		awayLay->setContentsMargins(0, 0, 0, 0);
-		awayLay->setSpacing(4);
-		awayLay->addWidget(minusAway, 0, Qt::AlignHCenter | Qt::AlignVCenter);
-		awayLay->addWidget(awaySpin, 0, Qt::AlignHCenter | Qt::AlignVCenter);
-		awayLay->addWidget(plusAway, 0, Qt::AlignHCenter | Qt::AlignVCenter);
-
-		grid->addWidget(homeBox, 0, 2, Qt::AlignHCenter | Qt::AlignVCenter);
-		grid->addWidget(awayBox, 0, 3, Qt::AlignHCenter | Qt::AlignVCenter);
+FlyCustomFieldUi FlyScoreDock::createCustomFieldRow(int i)
+{
+	FlyCustomFieldUi ui;
+	++widgetRebuilds_;
+
+	auto *row = new QWidget(this);
+	auto *grid = new QGridLayout(row);
+	grid->setContentsMargins(0, 0, 0, 0);
+	grid->setHorizontalSpacing(6);
+	grid->setVerticalSpacing(0);
+
+	auto *visibleCheck = new QCheckBox(row);
+	grid->addWidget(visibleCheck, 0, 0, Qt::AlignLeft | Qt::AlignVCenter);
+
+	auto *labelLbl = new QLabel(row);
+	labelLbl->setMinimumWidth(120);
+	grid->addWidget(labelLbl, 0, 1);
+
+	auto makeEmojiBtn = [](const QString &emoji, const QString &tooltip, QWidget *parent) {
+		auto *btn = new QPushButton(parent);
+		btn->setText(emoji);
+		btn->setToolTip(tooltip);
+		btn->setCursor(Qt::PointingHandCursor);
+		btn->setStyleSheet(
+			"QPushButton {"
+			"  font-family:'Segoe UI Emoji','Noto Color Emoji','Apple Color Emoji',sans-serif;"
+			"  font-size:8px;"
+			"  padding:0;"
+			"}");
+		return btn;
+	};
+
+	auto *homeSpin = new QSpinBox(row);
+	homeSpin->setRange(0, kFlyFieldValueMax);
+	homeSpin->setMaximumWidth(60);
+	homeSpin->setMaximumHeight(32);
+	homeSpin->setButtonSymbols(QAbstractSpinBox::NoButtons);
+
+	auto *minusHome = makeEmojiBtn(QStringLiteral("➖"), QStringLiteral("Home -1"), row);
+	auto *plusHome = makeEmojiBtn(QStringLiteral("➕"), QStringLiteral("Home +1"), row);
+
+	auto *awaySpin = new QSpinBox(row);
+	awaySpin->setRange(0, kFlyFieldValueMax);
+	awaySpin->setMaximumWidth(60);
+	awaySpin->setMaximumHeight(32);
+	awaySpin->setButtonSymbols(QAbstractSpinBox::NoButtons);
+
+	auto *minusAway = makeEmojiBtn(QStringLiteral("➖"), QStringLiteral("Guests -1"), row);
+	auto *plusAway = makeEmojiBtn(QStringLiteral("➕"), QStringLiteral("Guests +1"), row);
+
+	//const int h = homeSpin->sizeHint().height();
+	minusHome->setFixedSize(32, 32);
+	plusHome->setFixedSize(32, 32);
+	minusAway->setFixedSize(32, 32);
+	plusAway->setFixedSize(32, 32);
+
+	auto *homeBox = new QWidget(row);
+	auto *homeLay = new QHBoxLayout(homeBox);
+	homeLay->setContentsMargins(0, 0, 0, 0);
+	homeLay->setSpacing(4);
+	homeLay->addWidget(minusHome, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+	homeLay->addWidget(homeSpin, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+	homeLay->addWidget(plusHome, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+
+	auto *awayBox = new QWidget(row);
+	auto *awayLay = new QHBoxLayout(awayBox);
+	awayLay->setContentsMargins(0, 0, 0, 0);
+	awayLay->setSpacing(4);
+	awayLay->addWidget(minusAway, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+	awayLay->addWidget(awaySpin, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+	awayLay->addWidget(plusAway, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+
+	grid->addWidget(homeBox, 0, 2, Qt::AlignHCenter | Qt::AlignVCenter);
+	grid->addWidget(awayBox, 0, 3, Qt::AlignHCenter | Qt::AlignVCenter);
+
+	grid->setColumnStretch(1, 2);
+	grid->setColumnStretch(2, 1);
+	grid->setColumnStretch(3, 1);
+
+	customFieldsLayout_->addWidget(row);
+
+	ui.row = row;
+	ui.visibleCheck = visibleCheck;
+	ui.labelLbl = labelLbl;
+	ui.homeSpin = homeSpin;
+	ui.awaySpin = awaySpin;
+	ui.minusHome = minusHome;
+	ui.plusHome = plusHome;
+	ui.minusAway = minusAway;
+	ui.plusAway = plusAway;
+
+	// Each widget feeds a single-element mutation for its own index
+	connect(homeSpin, qOverload<int>(&QSpinBox::valueChanged), this,
+		[this, i](int v) { setCustomFieldValue(i, FlyFieldSide::Home, v); });
+	connect(awaySpin, qOverload<int>(&QSpinBox::valueChanged), this,
+		[this, i](int v) { setCustomFieldValue(i, FlyFieldSide::Away, v); });
+	connect(visibleCheck, &QCheckBox::toggled, this, [this, i](bool on) { setCustomFieldVisible(i, on); });
+
+	// valueChanged already applies the change; setValue is a no-op at the range limits
+	connect(minusHome, &QPushButton::clicked, this,
+		[homeSpin]() { homeSpin->setValue(std::max(0, homeSpin->value() - 1)); });
+	connect(plusHome, &QPushButton::clicked, this, [homeSpin]() { homeSpin->setValue(homeSpin->value() + 1); });
+	connect(minusAway, &QPushButton::clicked, this,
+		[awaySpin]() { awaySpin->setValue(std::max(0, awaySpin->value() - 1)); });
+	connect(plusAway, &QPushButton::clicked, this, [awaySpin]() { awaySpin->setValue(awaySpin->value() + 1); });
+
+	return ui;
+}
 
-		grid->setColumnStretch(1, 2);
-		grid->setColumnStretch(2, 1);
-		grid->setColumnStretch(3, 1);
+void FlyScoreDock::updateCustomFieldRow(FlyCustomFieldUi &ui, const FlyCustomField &cf)
+{
+	// State -> widgets only; signals are blocked so nothing echoes back into the state
+	const QString label = cf.label.isEmpty() ? QStringLiteral("(unnamed)") : cf.label;
+	if (ui.labelLbl && ui.labelLbl->text() != label)
+		ui.labelLbl->setText(label);
+
+	if (ui.visibleCheck && ui.visibleCheck->isChecked() != cf.visible) {
+		const QSignalBlocker block(ui.visibleCheck);
+		ui.visibleCheck->setChecked(cf.visible);
+	}
 
-		customFieldsLayout_->addWidget(row);
+	const int home = std::max(0, cf.home);
+	if (ui.homeSpin && ui.homeSpin->value() != home) {
+		const QSignalBlocker block(ui.homeSpin);
+		ui.homeSpin->setValue(home);
+	}
 
-		ui.row = row;
-		ui.visibleCheck = visibleCheck;
-		ui.labelLbl = labelLbl;
-		ui.homeSpin = homeSpin;
-		ui.awaySpin = awaySpin;
-		ui.minusHome = minusHome;
-		ui.plusHome = plusHome;
-		ui.minusAway = minusAway;
-		ui.plusAway = plusAway;
+	const int away = std::max(0, cf.away);
+	if (ui.awaySpin && ui.awaySpin->value() != away) {
+		const QSignalBlocker block(ui.awaySpin);
+		ui.awaySpin->setValue(away);
+	}
+}
 
-		auto sync = [this]() {
-			syncCustomFieldControlsToState();
-		};
+void FlyScoreDock::refreshCustomFieldRow(int index)
+{
+	if (index < 0 || index >= st_.custom_fields.size())
+		return;
 
-		connect(homeSpin, qOverload<int>(&QSpinBox::valueChanged), this, [sync](int) { sync(); });
-		connect(awaySpin, qOverload<int>(&QSpinBox::valueChanged), this, [sync](int) { sync(); });
-		connect(visibleCheck, &QCheckBox::toggled, this, [sync](bool) { sync(); });
+	if (index < customFields_.size())
+		updateCustomFieldRow(customFields_[index], st_.custom_fields[index]);
+	if (fieldsModel_)
+		fieldsModel_->refreshRow(index);
+}
 
-		connect(minusHome, &QPushButton::clicked, this, [homeSpin, sync]() {
-			homeSpin->setValue(std::max(0, homeSpin->value() - 1));
-			sync();
-		});
-		connect(plusHome, &QPushButton::clicked, this, [homeSpin, sync]() {
-			homeSpin->setValue(homeSpin->value() + 1);
-			sync();
-		});
-		connect(minusAway, &QPushButton::clicked, this, [awaySpin, sync]() {
-			awaySpin->setValue(std::max(0, awaySpin->value() - 1));
-			sync();
-		});
-		connect(plusAway, &QPushButton::clicked, this, [awaySpin, sync]() {
-			awaySpin->setValue(awaySpin->value() + 1);
-			sync();
-		});
+void FlyScoreDock::setCustomFieldValue(int index, FlyFieldSide side, int value)
+{
+	if (!fly_state_set_field_value(st_, index, side, value))
+		return;
 
-		customFields_.push_back(ui);
-	}
+	refreshCustomFieldRow(index);
+	saveState();
 }
 
-void FlyScoreDock::syncCustomFieldControlsToState()
+void FlyScoreDock::setCustomFieldVisible(int index, bool visible)
 {
-	st_.custom_fields.clear();
-	st_.custom_fields.reserve(customFields_.size());
-
-	for (const auto &ui : customFields_) {
-		FlyCustomField cf;
-		cf.label = ui.labelLbl ? ui.labelLbl->text() : QString();
-		cf.home = ui.homeSpin ? ui.homeSpin->value() : 0;
-		cf.away = ui.awaySpin ? ui.awaySpin->value() : 0;
-		cf.visible = ui.visibleCheck ? ui.visibleCheck->isChecked() : true;
-		st_.custom_fields.push_back(cf);
-	}
+	if (!fly_state_set_field_visible(st_, index, visible))
+		return;
 
+	refreshCustomFieldRow(index);
 	saveState();
 }
 
 // ------------------------------------------------------------
-// Timers quick controls (same logic you already had)
+// Timers quick controls
 // ------------------------------------------------------------
 
-void FlyScoreDock::clearAllTimerRows()
+void FlyScoreDock::trimTimerRows(int count)
 {
-	for (auto &ui : timers_) {
+	while (timers_.size() > count) {
+		FlyTimerUi ui = timers_.takeLast();
 		if (timersLayout_ && ui.row)
 			timersLayout_->removeWidget(ui.row);
 		if (ui.row)
 			ui.row->deleteLater();
 	}
-	timers_.clear();
 }
 
 void FlyScoreDock::loadTimerControlsFromState()
 {
-	clearAllTimerRows();
 	if (!timersLayout_)
 		return;
 
 	if (st_.timers.isEmpty()) {
 		FlyTimer main;
 		main.label = QStringLiteral("First Half");
-		main.mode = QStringLiteral("countdown");
+		main.mode = FlyTimerMode::Countdown;
 		main.running = false;
 		main.initial_ms = 0;
 		main.remaining_ms = 0;
 		main.last_tick_ms = 0;
 		st_.timers.push_back(main);
+		timerEngine_.load(st_.timers);
 	}
 
-	timers_.reserve(st_.timers.size());
+	const int n = st_.timers.size();
+	trimTimerRows(n);
+	while (timers_.size() < n)
+		timers_.push_back(createTimerRow(timers_.size()));
 
-	for (int i = 0; i < st_.timers.size(); ++i) {
-		const auto &tm = st_.timers[i];
-		FlyTimerUi ui;
-
-		auto *row = new QWidget(this);
-		auto *lay = new QHBoxLayout(row);
-		lay->setContentsMargins(0, 0, 0, 0);
-		lay->setSpacing(6);
-
-		auto *visibleCheck = new QCheckBox(row);
-		visibleCheck->setChecked(tm.visible);
-
-		auto *labelLbl = new QLabel(tm.label.isEmpty() ? QStringLiteral("(unnamed)") : tm.label, row);
-		labelLbl->setMinimumWidth(120);
+	for (int i = 0; i < n; ++i)
+		updateTimerRow(timers_[i], st_.timers[i]);
 
-		auto *timeEdit = new QLineEdit(row);
-		timeEdit->setPlaceholderText(QStringLiteral("mm:ss"));
-		timeEdit->setClearButtonEnabled(true);
-		timeEdit->setMaxLength(8);
-		timeEdit->setMinimumWidth(60);
-		timeEdit->setText(fly_format_ms_mmss(tm.remaining_ms));
-
-		auto makeEmojiBtn = [](const QString &emoji, const QString &tooltip, QWidget *parent) {
-			auto *btn = new QPushButton(parent);
-			btn->setText(emoji);
-			btn->setToolTip(tooltip);
-			btn->setCursor(Qt::PointingHandCursor);
-			btn->setStyleSheet(
-				"QPushButton {"
-				"  font-family:'Segoe UI Emoji','Noto Color Emoji','Apple Color Emoji',sans-serif;"
-				"  font-size:12px;"
-				"  padding:0;"
-				"}");
-			return btn;
-		};
-
-		auto *startStopBtn =
-			makeEmojiBtn(tm.running ? QStringLiteral("⏸️") : QStringLiteral("▶️"),
-				     tm.running ? QStringLiteral("Pause timer") : QStringLiteral("Start timer"), row);
-
-		auto *resetBtn = makeEmojiBtn(QStringLiteral("🔄️"), QStringLiteral("Reset timer"), row);
-
-		const int h = timeEdit->sizeHint().height();
-		startStopBtn->setFixedSize(h, h);
-		resetBtn->setFixedSize(h, h);
+	// st_.timers holds the value at the last commit; show running clocks live
+	if (timerEngine_.anyRunning())
+		onTimerTick();
+}
 
-		lay->addWidget(visibleCheck, 0, Qt::AlignVCenter);
-		lay->addWidget(labelLbl);
-		lay->addStretch(1);
-		lay->addWidget(timeEdit, 0, Qt::AlignVCenter);
-		lay->addWidget(startStopBtn, 0, Qt::AlignVCenter);
-		lay->addWidget(resetBtn, 0, Qt::AlignVCenter);
+FlyTimerUi FlyScoreDock::createTimerRow(int i)
+{
+	FlyTimerUi ui;
+	++widgetRebuilds_;
+
+	auto *row = new QWidget(this);
+	auto *lay = new QHBoxLayout(row);
+	lay->setContentsMargins(0, 0, 0, 0);
+	lay->setSpacing(6);
+
+	auto *visibleCheck = new QCheckBox(row);
+
+	auto *labelLbl = new QLabel(row);
+	labelLbl->setMinimumWidth(120);
+
+	auto *timeEdit = new QLineEdit(row);
+	timeEdit->setPlaceholderText(QStringLiteral("mm:ss"));
+	timeEdit->setClearButtonEnabled(true);
+	timeEdit->setMaxLength(8);
+	timeEdit->setMinimumWidth(60);
+
+	auto makeEmojiBtn = [](const QString &emoji, const QString &tooltip, QWidget *parent) {
+		auto *btn = new QPushButton(parent);
+		btn->setText(emoji);
+		btn->setToolTip(tooltip);
+		btn->setCursor(Qt::PointingHandCursor);
+		btn->setStyleSheet(
+			"QPushButton {"
+			"  font-family:'Segoe UI Emoji','Noto Color Emoji','Apple Color Emoji',sans-serif;"
+			"  font-size:12px;"
+			"  padding:0;"
+			"}");
+		return btn;
+	};
+
+	auto *startStopBtn = makeEmojiBtn(QStringLiteral("▶️"), QStringLiteral("Start timer"), row);
+
+	auto *resetBtn = makeEmojiBtn(QStringLiteral("🔄️"), QStringLiteral("Reset timer"), row);
+
+	const int h = timeEdit->sizeHint().height();
+	startStopBtn->setFixedSize(h, h);
+	resetBtn->setFixedSize(h, h);
+
+	lay->addWidget(visibleCheck, 0, Qt::AlignVCenter);
+	lay->addWidget(labelLbl);
+	lay->addStretch(1);
+	lay->addWidget(timeEdit, 0, Qt::AlignVCenter);
+	lay->addWidget(startStopBtn, 0, Qt::AlignVCenter);
+	lay->addWidget(resetBtn, 0, Qt::AlignVCenter);
+
+	timersLayout_->addWidget(row);
+
+	ui.row = row;
+	ui.labelLbl = labelLbl;
+	ui.timeEdit = timeEdit;
+	ui.startStop = startStopBtn;
+	ui.reset = resetBtn;
+	ui.visibleCheck = visibleCheck;
+
+	connect(visibleCheck, &QCheckBox::toggled, this, [this, i](bool on) {
+		if (timerEngine_.setVisible(i, on))
+			commitTimers();
+	});
 
-		timersLayout_->addWidget(row);
+	connect(timeEdit, &QLineEdit::editingFinished, this, [this, i, timeEdit]() {
+		if (i < 0 || i >= timerEngine_.count())
+			return;
 
-		ui.row = row;
-		ui.labelLbl = labelLbl;
-		ui.timeEdit = timeEdit;
-		ui.startStop = startStopBtn;
-		ui.reset = resetBtn;
-		ui.visibleCheck = visibleCheck;
+		// Presets can only be typed while the timer is stopped
+		const qint64 ms = timerEngine_.isRunning(i) ? -1 : fly_parse_mmss_to_ms(timeEdit->text());
+		if (ms >= 0 && timerEngine_.setPreset(i, ms))
+			commitTimers();
 
-		connect(visibleCheck, &QCheckBox::toggled, this, [this, i](bool on) {
-			if (i < 0 || i >= st_.timers.size())
-				return;
-			st_.timers[i].visible = on;
-			saveState();
-		});
+		timeEdit->setText(fly_format_ms_mmss(timerEngine_.valueMs(i)));
+	});
 
-		connect(timeEdit, &QLineEdit::editingFinished, this, [this, i, timeEdit]() {
-			if (i < 0 || i >= st_.timers.size())
-				return;
+	connect(startStopBtn, &QPushButton::clicked, this, [this, i]() { toggleTimerRunning(i); });
 
-			FlyTimer &t = st_.timers[i];
-			if (t.running) {
-				timeEdit->setText(fly_format_ms_mmss(t.remaining_ms));
-				return;
-			}
+	connect(resetBtn, &QPushButton::clicked, this, [this, i]() {
+		if (!timerEngine_.reset(i))
+			return;
 
-			qint64 ms = fly_parse_mmss_to_ms(timeEdit->text());
-			if (ms < 0) {
-				timeEdit->setText(fly_format_ms_mmss(t.remaining_ms));
-				return;
-			}
-
-			t.initial_ms = ms;
-			t.remaining_ms = ms;
-			saveState();
-			timeEdit->setText(fly_format_ms_mmss(t.remaining_ms));
-		});
-
-		connect(startStopBtn, &QPushButton::clicked, this, [this, i]() {
-			toggleTimerRunning(i);
-			refreshUiFromState(false);
-		});
-
-		connect(resetBtn, &QPushButton::clicked, this, [this, i]() {
-			if (i < 0 || i >= st_.timers.size())
-				return;
+		commitTimers();
+		if (i < timers_.size() && i < st_.timers.size())
+			updateTimerRow(timers_[i], st_.timers[i]);
+	});
 
-			FlyTimer &t = st_.timers[i];
-			qint64 ms = t.initial_ms;
-			if (ms < 0)
-				ms = 0;
+	return ui;
+}
 
-			t.remaining_ms = ms;
-			t.running = false;
-			t.last_tick_ms = 0;
+void FlyScoreDock::updateTimerRow(FlyTimerUi &ui, const FlyTimer &tm)
+{
+	const QString label = tm.label.isEmpty() ? QStringLiteral("(unnamed)") : tm.label;
+	if (ui.labelLbl && ui.labelLbl->text() != label)
+		ui.labelLbl->setText(label);
 
-			saveState();
-			refreshUiFromState(false);
-		});
+	if (ui.visibleCheck && ui.visibleCheck->isChecked() != tm.visible) {
+		const QSignalBlocker block(ui.visibleCheck);
+		ui.visibleCheck->setChecked(tm.visible);
+	}
 
-		timers_.push_back(ui);
+	// Don't clobber what the user is typing
+	const QString text = fly_format_ms_mmss(tm.remaining_ms);
+	if (ui.timeEdit && !ui.timeEdit->hasFocus() && ui.timeEdit->text() != text)
+		ui.timeEdit->setText(text);
+
+	if (ui.startStop) {
+		const QString icon = tm.running ? QStringLiteral("⏸️") : QStringLiteral("▶️");
+		if (ui.startStop->text() != icon) {
+			ui.startStop->setText(icon);
+			ui.startStop->setToolTip(tm.running ? QStringLiteral("Pause timer")
+							    : QStringLiteral("Start timer"));
+		}
 	}
 }
 
@@ -878,15 +1214,7 @@ void FlyScoreDock::bumpCustomFieldHome(int index, int delta)
 	if (index < 0 || index >= st_.custom_fields.size())
 		return;
 
-	// go through UI if possible
-	if (index < customFields_.size() && customFields_[index].homeSpin) {
-		auto *spin = customFields_[index].homeSpin;
-		spin->setValue(std::max(0, spin->value() + delta));
-		return;
-	}
-
-	st_.custom_fields[index].home = std::max(0, st_.custom_fields[index].home + delta);
-	saveState();
+	setCustomFieldValue(index, FlyFieldSide::Home, st_.custom_fields[index].home + delta);
 }
 
 void FlyScoreDock::bumpCustomFieldAway(int index, int delta)
@@ -894,14 +1222,7 @@ void FlyScoreDock::bumpCustomFieldAway(int index, int delta)
 	if (index < 0 || index >= st_.custom_fields.size())
 		return;
 
-	if (index < customFields_.size() && customFields_[index].awaySpin) {
-		auto *spin = customFields_[index].awaySpin;
-		spin->setValue(std::max(0, spin->value() + delta));
-		return;
-	}
-
-	st_.custom_fields[index].away = std::max(0, st_.custom_fields[index].away + delta);
-	saveState();
+	setCustomFieldValue(index, FlyFieldSide::Away, st_.custom_fields[index].away + delta);
 }
 
 void FlyScoreDock::toggleCustomFieldVisible(int index)
@@ -909,14 +1230,7 @@ void FlyScoreDock::toggleCustomFieldVisible(int index)
 	if (index < 0 || index >= st_.custom_fields.size())
 		return;
 
-	if (index < customFields_.size() && customFields_[index].visibleCheck) {
-		auto *chk = customFields_[index].visibleCheck;
-		chk->setChecked(!chk->isChecked());
-		return;
-	}
-
-	st_.custom_fields[index].visible = !st_.custom_fields[index].visible;
-	saveState();
+	setCustomFieldVisible(index, !st_.custom_fields[index].visible);
 }
 
 void FlyScoreDock::toggleSwap()
@@ -943,40 +1257,182 @@ void FlyScoreDock::toggleScoreboardVisible()
 
 void FlyScoreDock::toggleTimerRunning(int index)
 {
-	if (index < 0 || index >= st_.timers.size())
+	if (!timerEngine_.toggle(index))
 		return;
 
-	FlyTimer &tm = st_.timers[index];
-	const qint64 now = fly_now_ms();
+	commitTimers();
+	if (index < timers_.size() && index < st_.timers.size())
+		updateTimerRow(timers_[index], st_.timers[index]);
+}
 
-	if (!tm.running) {
-		if (tm.remaining_ms < 0) {
-			if (tm.mode == QStringLiteral("countdown"))
-				tm.remaining_ms = (tm.initial_ms > 0) ? tm.initial_ms : 0;
-			else
-				tm.remaining_ms = 0;
+void FlyScoreDock::commitTimers()
+{
+	st_.timers = timerEngine_.snapshot();
+
+	// Penalties follow the game clock
+	if (penalties_.setRunning(timerEngine_.isRunning(0))) {
+		st_.penalties = penalties_.snapshot();
+		updatePenaltyTickDriver();
+	}
+
+	if (frameClock_.isRunning())
+		frameClock_.setTimers(timerEngine_.anchors());
+	alarms_->rearm(timerEngine_.anchors());
+
+	saveState();
+	updateTimerTickDriver();
+}
+
+void FlyScoreDock::onTimerAlarm(int index, qint64 thresholdMs, qint64 lateMs)
+{
+	LOGI("Timer %d reached %lld ms (%lld ms late)", index, (long long)thresholdMs, (long long)lateMs);
+
+	if (thresholdMs == 0) {
+		if (st_.alarms.auto_pause && timerEngine_.pause(index)) {
+			commitTimers();
+			if (index < timers_.size() && index < st_.timers.size())
+				updateTimerRow(timers_[index], st_.timers[index]);
 		}
-		tm.last_tick_ms = now;
-		tm.running = true;
-	} else {
-		if (tm.last_tick_ms > 0) {
-			qint64 elapsed = now - tm.last_tick_ms;
-			if (elapsed < 0)
-				elapsed = 0;
-
-			if (tm.mode == QStringLiteral("countup"))
-				tm.remaining_ms += elapsed;
-			else {
-				tm.remaining_ms -= elapsed;
-				if (tm.remaining_ms < 0)
-					tm.remaining_ms = 0;
-			}
+
+#ifdef ENABLE_FRONTEND_API
+		if (!st_.alarms.expiry_scene.isEmpty()) {
+			obs_source_t *scene = obs_get_source_by_name(st_.alarms.expiry_scene.toUtf8().constData());
+			if (scene && obs_source_is_scene(scene))
+				obs_frontend_set_current_scene(scene);
+			else
+				LOGW("Expiry scene '%s' not found", st_.alarms.expiry_scene.toUtf8().constData());
+			obs_source_release(scene);
 		}
-		tm.running = false;
+#endif
+
+		if (!st_.alarms.expiry_action.isEmpty())
+			triggerAction(fly_action_parse(st_.alarms.expiry_action));
+	}
+
+	emit timerAlarm(index, thresholdMs);
+}
+
+void FlyScoreDock::applyFrameClock()
+{
+	if (frameClockCheck_ && frameClockCheck_->isChecked() != st_.frame_clock.enabled) {
+		const QSignalBlocker block(frameClockCheck_);
+		frameClockCheck_->setChecked(st_.frame_clock.enabled);
+	}
+
+	if (!st_.frame_clock.enabled) {
+		frameClock_.stop();
+		return;
+	}
+
+	// Restart so a changed precision takes effect; the sink runs on the graphics thread
+	frameClock_.setTimers(timerEngine_.anchors());
+	frameClock_.start([this](const QByteArray &json) { server_.publishFrame(json); },
+			  st_.frame_clock.decimals);
+}
+
+void FlyScoreDock::updateTimerTickDriver()
+{
+	const bool wanted = timerEngine_.anyRunning();
+	if (wanted && !timerTick_->isActive())
+		timerTick_->start();
+	else if (!wanted && timerTick_->isActive())
+		timerTick_->stop();
+}
+
+void FlyScoreDock::onTimerTick()
+{
+	// Display only: the state and the overlay are driven by the engine's anchors
+	const int n = std::min<int>(timers_.size(), timerEngine_.count());
+	for (int i = 0; i < n; ++i) {
+		if (!timerEngine_.isRunning(i))
+			continue;
+
+		QLineEdit *edit = timers_[i].timeEdit;
+		if (!edit || edit->hasFocus())
+			continue;
+
+		const QString text = fly_format_ms_mmss(timerEngine_.valueMs(i));
+		if (edit->text() != text)
+			edit->setText(text);
 	}
 
+	updateTimerTickDriver();
+}
+
+// ------------------------------------------------------------
+// Penalties
+// ------------------------------------------------------------
+
+void FlyScoreDock::addPenalty(FlyFieldSide side)
+{
+	penalties_.add(side, st_.penalty.duration_ms);
+	commitPenalties();
+}
+
+void FlyScoreDock::removePenalty(FlyFieldSide side)
+{
+	if (penalties_.remove(penalties_.soonest(side)))
+		commitPenalties();
+}
+
+void FlyScoreDock::commitPenalties()
+{
+	st_.penalties = penalties_.snapshot();
+	syncPenaltyField();
 	saveState();
-	refreshUiFromState(false);
+	updatePenaltyTickDriver();
+	refreshPenaltiesLabel();
+}
+
+void FlyScoreDock::syncPenaltyField()
+{
+	const int idx = st_.penalty.field_index;
+
+	bool changed = fly_state_set_field_value(st_, idx, FlyFieldSide::Home, penalties_.count(FlyFieldSide::Home));
+	changed |= fly_state_set_field_value(st_, idx, FlyFieldSide::Away, penalties_.count(FlyFieldSide::Away));
+	if (changed)
+		refreshCustomFieldRow(idx);
+}
+
+void FlyScoreDock::updatePenaltyTickDriver()
+{
+	const bool wanted = penalties_.isRunning() && !penalties_.empty();
+	if (wanted && !penaltyTick_->isActive())
+		penaltyTick_->start();
+	else if (!wanted && penaltyTick_->isActive())
+		penaltyTick_->stop();
+}
+
+void FlyScoreDock::onPenaltyTick()
+{
+	const QVector<FlyPenalty> expired = penalties_.advance();
+	if (expired.isEmpty()) {
+		refreshPenaltiesLabel();
+		return;
+	}
+
+	for (const FlyPenalty &p : expired)
+		LOGI("Penalty %u (%s) expired", p.id, p.side == FlyFieldSide::Away ? "guests" : "home");
+
+	commitPenalties();
+}
+
+void FlyScoreDock::refreshPenaltiesLabel()
+{
+	if (!penaltiesLbl_)
+		return;
+
+	// Snapshot is sorted by remaining time, so each side lists soonest first
+	QStringList home, away;
+	for (const FlyPenalty &p : penalties_.snapshot())
+		(p.side == FlyFieldSide::Away ? away : home).push_back(fly_format_ms_mmss(p.remaining_ms));
+
+	const QString none = QStringLiteral("—");
+	const QString text = QStringLiteral("H %1   G %2")
+				     .arg(home.isEmpty() ? none : home.join(QStringLiteral(" · ")),
+					  away.isEmpty() ? none : away.join(QStringLiteral(" · ")));
+	if (penaltiesLbl_->text() != text)
+		penaltiesLbl_->setText(text);
 }
 
 // ------------------------------------------------------------
@@ -985,30 +1441,37 @@ void FlyScoreDock::toggleTimerRunning(int index)
 
 void FlyScoreDock::onOpenCustomFieldsDialog()
 {
+	// Dialogs write plugin.json themselves; don't let a queued snapshot land after them
+	persist_.flush();
+
 	FlyFieldsDialog dlg(dataDir_, st_, this);
 	dlg.exec();
 
 	loadState();
 	refreshUiFromState(false);
 
-	hotkeyBindings_ = buildMergedHotkeyBindings();
-	applyHotkeyBindings(hotkeyBindings_);
+	applyHotkeyBindings(buildMergedHotkeyBindings());
 }
 
 void FlyScoreDock::onOpenTimersDialog()
 {
+	// Dialogs write plugin.json themselves; don't let a queued snapshot land after them
+	persist_.flush();
+
 	FlyTimersDialog dlg(dataDir_, st_, this);
 	dlg.exec();
 
 	loadState();
 	refreshUiFromState(false);
 
-	hotkeyBindings_ = buildMergedHotkeyBindings();
-	applyHotkeyBindings(hotkeyBindings_);
+	applyHotkeyBindings(buildMergedHotkeyBindings());
 }
 
 void FlyScoreDock::onOpenTeamsDialog()
 {
+	// Dialogs write plugin.json themselves; don't let a queued snapshot land after them
+	persist_.flush();
+
 	FlyTeamsDialog dlg(dataDir_, st_, this);
 	dlg.exec();
 
@@ -1024,6 +1487,109 @@ void FlyScoreDock::ensureResourcesDefaults()
 	fly_state_ensure_json_exists(resDir, &st_);
 }
 
+// ------------------------------------------------------------
+// Diagnostics
+// ------------------------------------------------------------
+
+FlyScoreDock::DiagSample FlyScoreDock::diagSample() const
+{
+	DiagSample d;
+	d.atUs = FlyStatePersister::nowUs();
+	d.persist = persist_.stats();
+	d.saves = saveCount_;
+	d.widgetRebuilds = widgetRebuilds_;
+	return d;
+}
+
+QStringList FlyScoreDock::diagnosticsLines(DiagSample &since) const
+{
+	const DiagSample now = diagSample();
+	const double secs = std::max(0.001, double(now.atUs - since.atUs) / 1e6);
+	const FlyStatePersister::Stats &a = since.persist;
+	const FlyStatePersister::Stats &b = now.persist;
+
+	const uint64_t writes = (b.written + b.failed) - (a.written + a.failed);
+	auto avgUs = [writes](int64_t totalA, int64_t totalB) {
+		return writes ? QString::number((totalB - totalA) / int64_t(writes)) : QStringLiteral("–");
+	};
+
+	QStringList lines;
+	lines << QStringLiteral("saves/s %1, writes/s %2 (coalesced %3, failed %4, queued %5)")
+			 .arg(double(now.saves - since.saves) / secs, 0, 'f', 1)
+			 .arg(double(writes) / secs, 0, 'f', 1)
+			 .arg(b.coalesced - a.coalesced)
+			 .arg(b.failed - a.failed)
+			 .arg(b.queue_depth);
+	lines << QStringLiteral("serialize avg %1 µs, write avg %2 µs (max %3 µs)")
+			 .arg(avgUs(a.serialize_us_total, b.serialize_us_total))
+			 .arg(avgUs(a.write_us_total, b.write_us_total))
+			 .arg(b.max_write_us);
+	lines << QStringLiteral("bytes written %1 (%2 B/s)")
+			 .arg(b.bytes_written)
+			 .arg(double(b.bytes_written - a.bytes_written) / secs, 0, 'f', 0);
+	lines << QStringLiteral("widget rebuilds %1 (+%2)")
+			 .arg(now.widgetRebuilds)
+			 .arg(now.widgetRebuilds - since.widgetRebuilds);
+	lines << QStringLiteral("hotkey→disk last %1 ms, max %2 ms")
+			 .arg(double(b.last_origin_latency_us) / 1000.0, 0, 'f', 1)
+			 .arg(double(b.max_origin_latency_us) / 1000.0, 0, 'f', 1);
+
+	if (probeEnabled_) {
+		const QStringList transports = server_.latency().transports();
+		if (transports.isEmpty())
+			lines << QStringLiteral("probe: waiting for overlay acks");
+		for (const QString &t : transports) {
+			const FlyLatencyProbe::Summary ls = server_.latency().summary(t);
+			lines << QStringLiteral("probe %1: p50 %2 ms, p95 %3 ms, p99 %4 ms (n=%5, max %6 ms)")
+					 .arg(t)
+					 .arg(ls.p50_ms)
+					 .arg(ls.p95_ms)
+					 .arg(ls.p99_ms)
+					 .arg(ls.count)
+					 .arg(ls.max_ms);
+		}
+	}
+
+	since = now;
+	return lines;
+}
+
+void FlyScoreDock::setLatencyProbe(bool on)
+{
+	if (probeEnabled_ == on)
+		return;
+	probeEnabled_ = on;
+
+	if (on) {
+		server_.latency().reset();
+		if (!server_.isRunning())
+			LOGW("Latency probe: overlay server is not running; overlays cannot report back");
+	} else {
+		st_.probe = FlyProbeStamp();
+	}
+
+	// Stamp (or drop the stamp) right away so open overlays see it
+	saveState();
+	LOGI("Latency probe %s", on ? "enabled" : "disabled");
+}
+
+void FlyScoreDock::refreshDiagnostics()
+{
+	if (diagLbl_)
+		diagLbl_->setText(diagnosticsLines(diagUiSince_).join(QLatin1Char('\n')));
+}
+
+void FlyScoreDock::logDiagnostics()
+{
+	// Quiet while nothing happens; an idle dock should not fill the log
+	if (saveCount_ == diagLogSince_.saves && widgetRebuilds_ == diagLogSince_.widgetRebuilds) {
+		diagLogSince_ = diagSample();
+		return;
+	}
+
+	LOGI("Diagnostics: %s", diagnosticsLines(diagLogSince_).join(QStringLiteral("; ")).toUtf8().constData());
+}
+
 // ------------------------------------------------------------
 // Dock registration with OBS frontend
 // ------------------------------------------------------------
@@ -0,0 +1,243 @@
+#include "fly_score_fields_model.hpp"
+
+#include <QApplication>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QSpinBox>
+#include <QStyle>
+
+#include <algorithm>
+
+static bool is_value_column(const QModelIndex &index)
+{
+	return index.column() == FlyCustomFieldsModel::ColHome || index.column() == FlyCustomFieldsModel::ColAway;
+}
+
+// -----------------------------------------------------------------------------
+// Model
+// -----------------------------------------------------------------------------
+
+FlyCustomFieldsModel::FlyCustomFieldsModel(FlyState *state, QObject *parent)
+	: QAbstractTableModel(parent),
+	  st_(state),
+	  rows_(state ? state->custom_fields.size() : 0)
+{
+}
+
+int FlyCustomFieldsModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : rows_;
+}
+
+int FlyCustomFieldsModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : ColCount;
+}
+
+QVariant FlyCustomFieldsModel::data(const QModelIndex &index, int role) const
+{
+	if (!st_ || !index.isValid() || index.row() >= st_->custom_fields.size())
+		return QVariant();
+
+	const FlyCustomField &cf = st_->custom_fields[index.row()];
+
+	switch (index.column()) {
+	case ColVisible:
+		if (role == Qt::CheckStateRole)
+			return cf.visible ? Qt::Checked : Qt::Unchecked;
+		break;
+	case ColLabel:
+		if (role == Qt::DisplayRole)
+			return cf.label.isEmpty() ? QStringLiteral("(unnamed)") : cf.label;
+		break;
+	case ColHome:
+		if (role == Qt::DisplayRole || role == Qt::EditRole)
+			return std::max(0, cf.home);
+		if (role == Qt::TextAlignmentRole)
+			return int(Qt::AlignCenter);
+		break;
+	case ColAway:
+		if (role == Qt::DisplayRole || role == Qt::EditRole)
+			return std::max(0, cf.away);
+		if (role == Qt::TextAlignmentRole)
+			return int(Qt::AlignCenter);
+		break;
+	default:
+		break;
+	}
+	return QVariant();
+}
+
+QVariant FlyCustomFieldsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	switch (section) {
+	case ColLabel:
+		return tr("Stat");
+	case ColHome:
+		return tr("Home");
+	case ColAway:
+		return tr("Guests");
+	default:
+		return QString();
+	}
+}
+
+bool FlyCustomFieldsModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+	if (!st_ || !index.isValid() || index.row() >= st_->custom_fields.size())
+		return false;
+
+	bool changed = false;
+	if (index.column() == ColVisible && role == Qt::CheckStateRole) {
+		changed = fly_state_set_field_visible(*st_, index.row(), value.toInt() == Qt::Checked);
+	} else if (is_value_column(index) && role == Qt::EditRole) {
+		const FlyFieldSide side = index.column() == ColHome ? FlyFieldSide::Home : FlyFieldSide::Away;
+		changed = fly_state_set_field_value(*st_, index.row(), side, value.toInt());
+	}
+
+	if (!changed)
+		return false;
+
+	emit dataChanged(index, index);
+	emit fieldEdited(index.row());
+	return true;
+}
+
+Qt::ItemFlags FlyCustomFieldsModel::flags(const QModelIndex &index) const
+{
+	if (!index.isValid())
+		return Qt::NoItemFlags;
+
+	Qt::ItemFlags f = Qt::ItemIsEnabled;
+	if (index.column() == ColVisible)
+		f |= Qt::ItemIsUserCheckable;
+	else if (is_value_column(index))
+		f |= Qt::ItemIsEditable;
+	return f;
+}
+
+void FlyCustomFieldsModel::reload()
+{
+	const int n = st_ ? st_->custom_fields.size() : 0;
+	if (n != rows_) {
+		beginResetModel();
+		rows_ = n;
+		endResetModel();
+		return;
+	}
+
+	if (rows_ > 0)
+		emit dataChanged(index(0, 0), index(rows_ - 1, ColCount - 1));
+}
+
+void FlyCustomFieldsModel::refreshRow(int row)
+{
+	if (row < 0 || row >= rows_)
+		return;
+	emit dataChanged(index(row, 0), index(row, ColCount - 1));
+}
+
+// -----------------------------------------------------------------------------
+// Delegate
+// -----------------------------------------------------------------------------
+
+// Button squares at both ends of the cell; the value sits in between
+static QRect minus_rect(const QRect &cell)
+{
+	const int s = cell.height() - 4;
+	return QRect(cell.left() + 2, cell.top() + 2, s, s);
+}
+
+static QRect plus_rect(const QRect &cell)
+{
+	const int s = cell.height() - 4;
+	return QRect(cell.right() - 1 - s, cell.top() + 2, s, s);
+}
+
+void FlyCustomFieldsDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+				    const QModelIndex &index) const
+{
+	if (!is_value_column(index)) {
+		QStyledItemDelegate::paint(painter, option, index);
+		return;
+	}
+
+	QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+
+	// Background/selection only; the text is drawn between the buttons below
+	QStyleOptionViewItem bg(option);
+	initStyleOption(&bg, index);
+	bg.text.clear();
+	style->drawControl(QStyle::CE_ItemViewItem, &bg, painter, option.widget);
+
+	auto drawButton = [&](const QRect &r, const QString &text) {
+		QStyleOptionButton b;
+		b.rect = r;
+		b.text = text;
+		b.state = QStyle::State_Enabled | QStyle::State_Raised;
+		style->drawControl(QStyle::CE_PushButton, &b, painter, option.widget);
+	};
+
+	const QRect minus = minus_rect(option.rect);
+	const QRect plus = plus_rect(option.rect);
+	drawButton(minus, QStringLiteral("−"));
+	drawButton(plus, QStringLiteral("+"));
+
+	const QRect textRect(minus.right() + 4, option.rect.top(), plus.left() - minus.right() - 8,
+			     option.rect.height());
+	painter->save();
+	painter->setPen(option.palette.color(QPalette::Text));
+	painter->drawText(textRect, Qt::AlignCenter, index.data(Qt::DisplayRole).toString());
+	painter->restore();
+}
+
+QSize FlyCustomFieldsDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+	QSize s = QStyledItemDelegate::sizeHint(option, index);
+	s.setHeight(std::max(s.height(), 26));
+	if (is_value_column(index))
+		s.setWidth(std::max(s.width(), 2 * s.height() + 40));
+	return s;
+}
+
+QWidget *FlyCustomFieldsDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+					       const QModelIndex &index) const
+{
+	if (!is_value_column(index))
+		return QStyledItemDelegate::createEditor(parent, option, index);
+
+	auto *spin = new QSpinBox(parent);
+	spin->setRange(0, kFlyFieldValueMax);
+	spin->setButtonSymbols(QAbstractSpinBox::NoButtons);
+	spin->setAlignment(Qt::AlignCenter);
+	return spin;
+}
+
+bool FlyCustomFieldsDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+					  const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+	if (is_value_column(index) && event->type() == QEvent::MouseButtonRelease) {
+		const auto *me = static_cast<QMouseEvent *>(event);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+		const QPoint pos = me->position().toPoint();
+#else
+		const QPoint pos = me->pos();
+#endif
+
+		int delta = 0;
+		if (minus_rect(option.rect).contains(pos))
+			delta = -1;
+		else if (plus_rect(option.rect).contains(pos))
+			delta = +1;
+
+		if (delta != 0) {
+			model->setData(index, index.data(Qt::EditRole).toInt() + delta, Qt::EditRole);
+			return true;
+		}
+	}
+
+	return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
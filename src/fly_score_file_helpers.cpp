@@ -0,0 +1,77 @@
+#include "config.hpp"
+
+#define LOG_TAG "[" PLUGIN_NAME "][file]"
+#include "fly_score_log.hpp"
+
+#include "fly_score_file_helpers.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static bool sync_handle(int fd)
+{
+	if (fd < 0)
+		return false;
+#ifdef _WIN32
+	return _commit(fd) == 0;
+#else
+	return ::fsync(fd) == 0;
+#endif
+}
+
+static std::filesystem::path to_fs_path(const QString &p)
+{
+	return std::filesystem::path(p.toStdU16String());
+}
+
+bool fly_atomic_write_file(const QString &path, const QByteArray &data, FlyFsyncPolicy fsync)
+{
+	const QFileInfo fi(path);
+	QDir().mkpath(fi.absolutePath());
+
+	// Unique per call so two writers of the same file never share a temp file
+	const QString tmpPath = QStringLiteral("%1.%2.tmp")
+					.arg(fi.absoluteFilePath())
+					.arg(QRandomGenerator::global()->generate(), 8, 16, QLatin1Char('0'));
+
+	QFile f(tmpPath);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		LOGW("Cannot open temp file %s: %s", tmpPath.toUtf8().constData(),
+		     f.errorString().toUtf8().constData());
+		return false;
+	}
+
+	bool ok = f.write(data) == data.size() && f.flush();
+	if (ok && fsync == FlyFsyncPolicy::Always)
+		ok = sync_handle(f.handle());
+	f.close();
+
+	if (!ok) {
+		LOGW("Failed writing temp file %s", tmpPath.toUtf8().constData());
+		QFile::remove(tmpPath);
+		return false;
+	}
+
+	// std::filesystem::rename replaces an existing target atomically
+	// (rename(2) on POSIX, MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows).
+	std::error_code ec;
+	std::filesystem::rename(to_fs_path(tmpPath), to_fs_path(fi.absoluteFilePath()), ec);
+	if (ec) {
+		LOGW("Failed replacing %s: %s", path.toUtf8().constData(), ec.message().c_str());
+		QFile::remove(tmpPath);
+		return false;
+	}
+
+	return true;
+}
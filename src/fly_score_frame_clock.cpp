@@ -0,0 +1,132 @@
+#include "config.hpp"
+
+#define LOG_TAG "[" PLUGIN_NAME "][frame-clock]"
+#include "fly_score_log.hpp"
+
+#include "fly_score_frame_clock.hpp"
+
+#include <obs.h>
+#include <util/platform.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QVarLengthArray>
+
+#include <algorithm>
+
+FlyFrameClock::~FlyFrameClock()
+{
+	stop();
+}
+
+void FlyFrameClock::start(Sink sink, int decimals)
+{
+	stop();
+
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		sink_ = std::move(sink);
+		decimals_ = std::clamp(decimals, 0, 2);
+		lastText_.clear();
+		dirty_ = true;
+	}
+
+	running_.store(true);
+	obs_add_tick_callback(&FlyFrameClock::onTick, this);
+	LOGI("Frame clock on (%d decimals)", decimals_);
+}
+
+void FlyFrameClock::stop()
+{
+	if (!running_.exchange(false))
+		return;
+
+	// Returns once the graphics thread is no longer inside onTick()
+	obs_remove_tick_callback(&FlyFrameClock::onTick, this);
+
+	std::lock_guard<std::mutex> lk(mtx_);
+	sink_ = nullptr;
+	LOGI("Frame clock off");
+}
+
+void FlyFrameClock::setTimers(const QVector<FlyTimerEngine::Anchor> &anchors)
+{
+	std::lock_guard<std::mutex> lk(mtx_);
+	anchors_ = anchors;
+	dirty_ = true;
+}
+
+QString FlyFrameClock::formatMs(int64_t ms, int decimals)
+{
+	ms = std::max<int64_t>(0, ms);
+
+	// Shot-clock style below a minute: "9.8", "24.0", "3.47"
+	if (decimals > 0 && ms < 60000) {
+		const int64_t unit = decimals == 1 ? 100 : 10;
+		const int64_t frac = (ms % 1000) / unit;
+		return QStringLiteral("%1.%2").arg(ms / 1000).arg(frac, decimals, 10, QLatin1Char('0'));
+	}
+
+	const int64_t m = ms / 60000;
+	const int64_t s = (ms % 60000) / 1000;
+	return QStringLiteral("%1:%2").arg(m, 2, 10, QLatin1Char('0')).arg(s, 2, 10, QLatin1Char('0'));
+}
+
+void FlyFrameClock::onTick(void *param, float seconds)
+{
+	Q_UNUSED(seconds);
+	static_cast<FlyFrameClock *>(param)->tick();
+}
+
+void FlyFrameClock::tick()
+{
+	// Frame timestamp -> engine steady clock: both are monotonic, so the
+	// offset between them is sampled fresh each frame.
+	const uint64_t frameNs = obs_get_video_frame_time();
+	const int64_t lagMs = (int64_t(os_gettime_ns()) - int64_t(frameNs)) / 1000000;
+	const int64_t frameSteadyMs = FlyTimerEngine::steadyNowMs() - lagMs;
+
+	QByteArray payload;
+	Sink sink;
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		if (!sink_ || anchors_.isEmpty())
+			return;
+
+		const int n = int(anchors_.size());
+		bool changed = dirty_ || lastText_.size() != n;
+		lastText_.resize(n);
+
+		QVarLengthArray<int64_t, 8> values(n);
+		for (int i = 0; i < n; ++i) {
+			values[i] = FlyTimerEngine::valueAt(anchors_[i], frameSteadyMs);
+			const QString text = formatMs(values[i], decimals_);
+			if (lastText_[i] != text) {
+				lastText_[i] = text;
+				changed = true;
+			}
+		}
+
+		// Nothing visible moved on this frame
+		if (!changed)
+			return;
+		dirty_ = false;
+
+		QJsonArray timers;
+		for (int i = 0; i < n; ++i) {
+			QJsonObject t;
+			t["ms"] = double(values[i]);
+			t["text"] = lastText_[i];
+			timers.append(t);
+		}
+
+		QJsonObject o;
+		o["frame_ns"] = double(frameNs);
+		o["timers"] = timers;
+		payload = QJsonDocument(o).toJson(QJsonDocument::Compact);
+		sink = sink_;
+	}
+
+	sink(payload);
+}
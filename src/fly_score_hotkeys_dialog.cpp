@@ -1,4 +1,6 @@
 #include "fly_score_hotkeys_dialog.hpp"
+#include "fly_score_file_helpers.hpp"
+#include "fly_score_actions.hpp"
 
 #include <QAbstractButton>
 #include <QDialogButtonBox>
@@ -99,12 +101,17 @@ void FlyHotkeysDialog::buildUi(const QVector<FlyHotkeyBinding> &initial)
 	QVector<FlyHotkeyBinding> timers;
 
 	for (const auto &b : initial) {
-		if (b.actionId.startsWith(QLatin1String("field_")))
+		switch (fly_action_group(fly_action_parse(b.actionId).kind)) {
+		case FlyActionGroup::Fields:
 			fields.push_back(b);
-		else if (b.actionId.startsWith(QLatin1String("timer_")))
+			break;
+		case FlyActionGroup::Timers:
 			timers.push_back(b);
-		else
+			break;
+		default:
 			scoreboard.push_back(b);
+			break;
+		}
 	}
 
 	QWidget *scorePage = createSectionPage(tr("Scoreboard"), scoreboard, 0);
@@ -315,11 +322,6 @@ bool fly_hotkeys_save(const QString &dataDir, const QVector<FlyHotkeyBinding> &b
 	const QJsonDocument doc(arr);
 	const QString path = hotkeysFilePath(dataDir);
 
-	QDir().mkpath(QFileInfo(path).absolutePath());
-	QFile f(path);
-	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
-		return false;
-
-	f.write(doc.toJson(QJsonDocument::Compact));
-	return true;
+	// Rarely written and painful to lose, so pay for the fsync
+	return fly_atomic_write_file(path, doc.toJson(QJsonDocument::Compact), FlyFsyncPolicy::Always);
 }
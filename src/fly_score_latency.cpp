@@ -0,0 +1,63 @@
+#include "fly_score_latency.hpp"
+
+#include <algorithm>
+
+void FlyLatencyProbe::record(const QString &transport, int64_t latencyMs)
+{
+	// Clocks of the plugin and the overlay are the same wall clock, but a step
+	// in between can still produce a negative span
+	latencyMs = std::max<int64_t>(0, latencyMs);
+
+	std::lock_guard<std::mutex> lk(mtx_);
+	Ring &r = rings_[transport];
+	if (r.samples.size() < kCapacity) {
+		r.samples.push_back(latencyMs);
+	} else {
+		r.samples[r.next] = latencyMs;
+		r.next = (r.next + 1) % kCapacity;
+	}
+	++r.count;
+}
+
+void FlyLatencyProbe::reset()
+{
+	std::lock_guard<std::mutex> lk(mtx_);
+	rings_.clear();
+}
+
+QStringList FlyLatencyProbe::transports() const
+{
+	std::lock_guard<std::mutex> lk(mtx_);
+	QStringList out = rings_.keys();
+	out.sort();
+	return out;
+}
+
+FlyLatencyProbe::Summary FlyLatencyProbe::summary(const QString &transport) const
+{
+	std::vector<int64_t> v;
+	Summary s;
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		auto it = rings_.constFind(transport);
+		if (it == rings_.constEnd())
+			return s;
+		v = it->samples;
+		s.count = it->count;
+	}
+	if (v.empty())
+		return s;
+
+	std::sort(v.begin(), v.end());
+	auto rank = [&v](int pct) {
+		// Nearest rank: the smallest sample with at least pct% at or below it
+		const size_t n = v.size();
+		const size_t idx = (size_t(pct) * n + 99) / 100;
+		return v[std::clamp<size_t>(idx, 1, n) - 1];
+	};
+	s.p50_ms = rank(50);
+	s.p95_ms = rank(95);
+	s.p99_ms = rank(99);
+	s.max_ms = v.back();
+	return s;
+}
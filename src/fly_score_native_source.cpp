@@ -0,0 +1,201 @@
+#include "config.hpp"
+
+#define LOG_TAG "[" PLUGIN_NAME "][native-source]"
+#include "fly_score_log.hpp"
+
+#include "fly_score_native_source.hpp"
+#include "fly_score_const.hpp"
+
+#include <obs-module.h>
+#include <obs.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <mutex>
+
+// -----------------------------------------------------------------------------
+// Live source registry (sources are created/destroyed on OBS threads)
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct FlyNativeEntry {
+	obs_source_t *source = nullptr;
+	bool primed = false; // has received at least one frame
+};
+
+std::mutex g_mtx;
+QVector<FlyNativeEntry> g_sources;
+FlyNativeScoreboard *g_board = nullptr;
+
+} // namespace
+
+// Caller holds g_mtx, which also keeps `source` alive (destroy takes it too)
+static void fly_output_frame(obs_source_t *source, const QImage &img)
+{
+	if (img.isNull()) {
+		obs_source_output_video(source, nullptr);
+		return;
+	}
+
+	obs_source_frame frame = {};
+	frame.data[0] = const_cast<uint8_t *>(img.constBits());
+	frame.linesize[0] = uint32_t(img.bytesPerLine());
+	frame.width = uint32_t(img.width());
+	frame.height = uint32_t(img.height());
+	frame.format = VIDEO_FORMAT_BGRA; // QImage::Format_ARGB32 on little-endian
+	frame.full_range = true;
+	frame.timestamp = os_gettime_ns();
+
+	// Copied by libobs; img may change right after
+	obs_source_output_video(source, &frame);
+}
+
+static const char *fly_native_get_name(void *)
+{
+	return kNativeSourceName;
+}
+
+static void *fly_native_create(obs_data_t *settings, obs_source_t *source)
+{
+	Q_UNUSED(settings);
+
+	// Show each frame as soon as it arrives; there is no stream to pace
+	obs_source_set_async_unbuffered(source, true);
+
+	std::lock_guard<std::mutex> lk(g_mtx);
+	g_sources.push_back({source, false});
+
+	// Prime the new source from the UI thread. Posted under the lock so the
+	// board cannot be destroyed in between; a pending call dies with it.
+	if (g_board) {
+		FlyNativeScoreboard *board = g_board;
+		QMetaObject::invokeMethod(board, [board]() { board->refresh(); }, Qt::QueuedConnection);
+	}
+	return source;
+}
+
+static void fly_native_destroy(void *data)
+{
+	auto *source = static_cast<obs_source_t *>(data);
+
+	std::lock_guard<std::mutex> lk(g_mtx);
+	g_sources.erase(std::remove_if(g_sources.begin(), g_sources.end(),
+				       [source](const FlyNativeEntry &e) { return e.source == source; }),
+			g_sources.end());
+}
+
+void fly_register_native_source()
+{
+	obs_source_info info = {};
+	info.id = kNativeSourceId;
+	info.type = OBS_SOURCE_TYPE_INPUT;
+	info.output_flags = OBS_SOURCE_ASYNC_VIDEO | OBS_SOURCE_DO_NOT_DUPLICATE;
+	info.icon_type = OBS_ICON_TYPE_TEXT;
+	info.get_name = fly_native_get_name;
+	info.create = fly_native_create;
+	info.destroy = fly_native_destroy;
+
+	obs_register_source(&info);
+	LOGI("Registered native scoreboard source '%s'", kNativeSourceId);
+}
+
+// -----------------------------------------------------------------------------
+// FlyNativeScoreboard
+// -----------------------------------------------------------------------------
+
+FlyNativeScoreboard::FlyNativeScoreboard(QObject *parent)
+	: QObject(parent),
+	  renderer_(kBrowserWidth, kBrowserHeight)
+{
+	digitTimer_.setSingleShot(true);
+	digitTimer_.setTimerType(Qt::PreciseTimer);
+	connect(&digitTimer_, &QTimer::timeout, this, &FlyNativeScoreboard::refresh);
+
+	std::lock_guard<std::mutex> lk(g_mtx);
+	g_board = this;
+}
+
+FlyNativeScoreboard::~FlyNativeScoreboard()
+{
+	std::lock_guard<std::mutex> lk(g_mtx);
+	if (g_board == this)
+		g_board = nullptr;
+}
+
+void FlyNativeScoreboard::setDocRoot(const QString &docRoot)
+{
+	renderer_.setDocRoot(docRoot);
+}
+
+void FlyNativeScoreboard::publish(const FlyState &st, const QVector<FlyTimerEngine::Anchor> &anchors)
+{
+	st_ = st;
+	anchors_ = anchors;
+	refresh();
+}
+
+void FlyNativeScoreboard::refresh()
+{
+	{
+		std::lock_guard<std::mutex> lk(g_mtx);
+		if (g_sources.isEmpty()) {
+			digitTimer_.stop();
+			return;
+		}
+	}
+
+	const int64_t now = FlyTimerEngine::steadyNowMs();
+
+	QVector<int64_t> timerMs;
+	const int n = std::min<int>(FlyScoreRenderer::kRenderedTimers, int(anchors_.size()));
+	for (int i = 0; i < n; ++i)
+		timerMs.push_back(FlyTimerEngine::valueAt(anchors_[i], now));
+
+	const bool changed = renderer_.update(st_, timerMs);
+
+	{
+		std::lock_guard<std::mutex> lk(g_mtx);
+		for (FlyNativeEntry &e : g_sources) {
+			if (changed || !e.primed) {
+				fly_output_frame(e.source, renderer_.frame());
+				e.primed = true;
+			}
+		}
+	}
+
+	armNextChange(now);
+}
+
+void FlyNativeScoreboard::armNextChange(int64_t steadyNow)
+{
+	int64_t wait = -1;
+
+	if (st_.show_scoreboard) {
+		const int n = std::min<int>({FlyScoreRenderer::kRenderedTimers, int(anchors_.size()),
+					     int(st_.timers.size())});
+		for (int i = 0; i < n; ++i) {
+			const FlyTimerEngine::Anchor &a = anchors_[i];
+			if (!a.running || !FlyScoreRenderer::timerDrawn(st_, i))
+				continue;
+
+			// mm:ss floors to whole seconds: the text flips when the value
+			// crosses the next multiple of 1000 ms in its direction
+			const int64_t v = FlyTimerEngine::valueAt(a, steadyNow);
+			int64_t w;
+			if (a.mode == FlyTimerMode::Countdown) {
+				if (v <= 0)
+					continue;
+				w = v % 1000 + 1;
+			} else {
+				w = 1000 - v % 1000;
+			}
+			wait = wait < 0 ? w : std::min(wait, w);
+		}
+	}
+
+	if (wait < 0)
+		digitTimer_.stop();
+	else
+		digitTimer_.start(int(wait));
+}
@@ -6,7 +6,10 @@
 
 #include "fly_score_qt_helpers.hpp"
 #include "fly_score_const.hpp"
+#include "fly_score_source_tracker.hpp"
+#include "fly_score_profiler.hpp"
 
+#include <obs-module.h>
 #include <obs.h>
 
 #ifdef ENABLE_FRONTEND_API
@@ -24,33 +27,67 @@
 // Create/update Browser Source in current scene
 // -----------------------------------------------------------------------------
 
-#ifdef ENABLE_FRONTEND_API
-static obs_scene_t *fly_get_current_scene()
+// The managed sources, tracked across all scenes (see FlySourceTracker)
+static FlySourceTracker g_browserTracker(kBrowserSourceId, kBrowserSourceName);
+static FlySourceTracker g_nativeTracker(kNativeSourceId, nullptr);
+
+static void fly_add_at_default_pos(obs_scene_t *scene, obs_source_t *src)
 {
-    obs_source_t *cur = obs_frontend_get_current_scene();
-    if (!cur)
-        return nullptr;
+	obs_sceneitem_t *item = obs_scene_add(scene, src);
+	vec2 pos = {40.0f, 40.0f};
+	obs_sceneitem_set_pos(item, &pos);
+}
 
-    obs_scene_t *scn = obs_scene_from_source(cur);
-    obs_source_release(cur);
-    return scn;
+// Copy into `delta` the keys of `wanted` whose values differ from `current`; returns how many
+static int fly_browser_settings_delta(obs_data_t *current, obs_data_t *wanted, obs_data_t *delta)
+{
+	static const char *kStrings[] = {"css", "url", "local_file"};
+	static const char *kInts[] = {"width", "height", "fps"};
+	static const char *kBools[] = {"is_local_file", "fps_custom", "shutdown"};
+
+	int n = 0;
+
+	for (const char *k : kStrings) {
+		const char *v = obs_data_get_string(wanted, k);
+		if (obs_data_has_user_value(wanted, k) && strcmp(obs_data_get_string(current, k), v) != 0) {
+			obs_data_set_string(delta, k, v);
+			++n;
+		}
+	}
+	for (const char *k : kInts) {
+		const long long v = obs_data_get_int(wanted, k);
+		if (obs_data_has_user_value(wanted, k) && obs_data_get_int(current, k) != v) {
+			obs_data_set_int(delta, k, v);
+			++n;
+		}
+	}
+	for (const char *k : kBools) {
+		const bool v = obs_data_get_bool(wanted, k);
+		if (obs_data_has_user_value(wanted, k) && obs_data_get_bool(current, k) != v) {
+			obs_data_set_bool(delta, k, v);
+			++n;
+		}
+	}
+	return n;
 }
-#endif
 
-bool fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex)
+FlyBrowserSync fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex,
+							  const FlyBrowserSourceConfig &cfg)
 {
+	FLY_PROFILE_SCOPE("fly_ensure_browser_source_in_current_scene");
+
 #ifdef ENABLE_FRONTEND_API
 	obs_source_t *sceneSource = obs_frontend_get_current_scene();
 	if (!sceneSource) {
 		LOGW("No current scene (obs_frontend_get_current_scene returned null)");
-		return false;
+		return FlyBrowserSync::Failed;
 	}
 
     obs_scene_t *scene = obs_scene_from_source(sceneSource);
     if (!scene) {
 	    LOGW("Current source is not a scene");
 	    obs_source_release(sceneSource);
-	    return false;
+	    return FlyBrowserSync::Failed;
     }
 
     // If urlOrLocalIndex points to an existing file, use the Browser Source "Local File" mode.
@@ -58,31 +95,18 @@ bool fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex)
     const QString localIndex = isLocal ? QDir::cleanPath(urlOrLocalIndex) : QString();
     const QString url = isLocal ? QString() : urlOrLocalIndex;
 
-    // Find existing browser source item by name
-    obs_sceneitem_t *item = nullptr;
-    obs_source_t *br = nullptr;
-
-    obs_scene_enum_items(
-	    scene,
-	    [](obs_scene_t *, obs_sceneitem_t *it, void *param) {
-		    auto **outItem = static_cast<obs_sceneitem_t **>(param);
-		    obs_source_t *src = obs_sceneitem_get_source(it);
-		    if (!src)
-			    return true;
-		    if (strcmp(obs_source_get_name(src), kBrowserSourceName) == 0 &&
-			strcmp(obs_source_get_id(src), kBrowserSourceId) == 0) {
-			    *outItem = it;
-			    return false;
-		    }
-		    return true;
-	    },
-	    &item);
-
-    // NOTE: obs_sceneitem_get_source returns a borrowed pointer; obtain a ref-counted one.
-    if (item) {
-	    obs_source_t *borrowed = obs_sceneitem_get_source(item);
-	    if (borrowed)
-		    br = obs_source_get_ref(borrowed);
+    // One source shared by every scene it appears in; the tracker keeps a weak
+    // reference, and the name lookup (hashed in libobs) catches one that is
+    // not placed in any scene yet.
+    obs_source_t *br = g_browserTracker.source();
+    if (!br) {
+	    obs_source_t *named = obs_get_source_by_name(kBrowserSourceName);
+	    if (named && strcmp(obs_source_get_id(named), kBrowserSourceId) == 0) {
+		    br = named;
+		    g_browserTracker.adopt(br);
+	    } else {
+		    obs_source_release(named);
+	    }
     }
 
     obs_data_t *settings = obs_data_create();
@@ -92,6 +116,13 @@ bool fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex)
     // Always clear CSS from plugin-managed source, to avoid stale user CSS
     obs_data_set_string(settings, "css", "");
 
+    // The overlay only changes when the state does (a digit per second while a
+    // clock runs), so CEF does not need to paint at a 60 fps canvas rate.
+    obs_data_set_bool(settings, "fps_custom", cfg.fps > 0);
+    if (cfg.fps > 0)
+	    obs_data_set_int(settings, "fps", cfg.fps);
+    obs_data_set_bool(settings, "shutdown", cfg.shutdown_when_hidden);
+
     if (isLocal) {
 	    obs_data_set_bool(settings, "is_local_file", true);
 	    obs_data_set_string(settings, "local_file", localIndex.toUtf8().constData());
@@ -103,40 +134,106 @@ bool fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex)
 	    obs_data_set_string(settings, "local_file", "");
     }
 
+    FlyBrowserSync result;
+
     if (br) {
-	    obs_source_update(br, settings);
-	    LOGI("Updated Browser Source '%s' -> %s", kBrowserSourceName,
+	    obs_data_t *current = obs_source_get_settings(br);
+	    obs_data_t *delta = obs_data_create();
+	    const int changed = fly_browser_settings_delta(current, settings, delta);
+	    obs_data_release(current);
+
+	    // Updating the one source covers every scene showing it
+	    if (changed == 0) {
+		    result = FlyBrowserSync::Unchanged;
+		    LOGI("Browser Source '%s' already up to date", kBrowserSourceName);
+	    } else {
+		    result = FlyBrowserSync::Updated;
+		    obs_source_update(br, delta);
+		    LOGI("Updated Browser Source '%s' -> %s (in %d scene(s))", kBrowserSourceName,
+			 isLocal ? localIndex.toUtf8().constData() : url.toUtf8().constData(),
+			 g_browserTracker.sceneCount());
+	    }
+	    obs_data_release(delta);
+    } else {
+	    // Public (not private) so it is listed, saved with the collection and
+	    // can be added to other scenes as an existing source
+	    br = obs_source_create(kBrowserSourceId, kBrowserSourceName, settings, nullptr);
+	    if (!br) {
+		    LOGW("Failed to create Browser Source");
+		    obs_data_release(settings);
+		    obs_source_release(sceneSource);
+		    return FlyBrowserSync::Failed;
+	    }
+	    g_browserTracker.adopt(br);
+	    result = FlyBrowserSync::Created;
+
+	    LOGI("Created Browser Source '%s' -> %s", kBrowserSourceName,
 		 isLocal ? localIndex.toUtf8().constData() : url.toUtf8().constData());
-	    obs_source_release(br);
-	    obs_data_release(settings);
-	    obs_source_release(sceneSource);
-	    return true;
-    }
-
-    // Create
-    br = obs_source_create_private(kBrowserSourceId, kBrowserSourceName, settings);
-    if (!br) {
-	    LOGW("Failed to create Browser Source");
-	    obs_data_release(settings);
-	    obs_source_release(sceneSource);
-	    return false;
     }
 
-    item = obs_scene_add(scene, br);
+    if (!g_browserTracker.inScene(sceneSource))
+	    fly_add_at_default_pos(scene, br);
 
-    // Position
-    vec2 pos = {40.0f, 40.0f};
-    obs_sceneitem_set_pos(item, &pos);
-
-    LOGI("Created Browser Source '%s' -> %s", kBrowserSourceName,
-	 isLocal ? localIndex.toUtf8().constData() : url.toUtf8().constData());
     obs_source_release(br);
     obs_data_release(settings);
     obs_source_release(sceneSource);
-    return true;
+    return result;
 #else
 	Q_UNUSED(urlOrLocalIndex);
+	Q_UNUSED(cfg);
 	LOGW("Frontend API not available; cannot create Browser Source.");
+	return FlyBrowserSync::Failed;
+#endif
+}
+
+bool fly_ensure_native_source_in_current_scene()
+{
+#ifdef ENABLE_FRONTEND_API
+	obs_source_t *sceneSource = obs_frontend_get_current_scene();
+	obs_scene_t *scene = sceneSource ? obs_scene_from_source(sceneSource) : nullptr;
+	if (!scene) {
+		LOGW("No current scene; cannot add native scoreboard source");
+		obs_source_release(sceneSource);
+		return false;
+	}
+
+	if (g_nativeTracker.inScene(sceneSource)) {
+		obs_source_release(sceneSource);
+		return true;
+	}
+
+	// Reuse the one placed elsewhere, if any
+	obs_source_t *src = g_nativeTracker.source();
+	if (!src) {
+		src = obs_source_create(kNativeSourceId, kNativeSourceName, nullptr, nullptr);
+		if (!src) {
+			LOGW("Failed to create native scoreboard source");
+			obs_source_release(sceneSource);
+			return false;
+		}
+		g_nativeTracker.adopt(src);
+		LOGI("Created native scoreboard source '%s'", kNativeSourceName);
+	}
+
+	fly_add_at_default_pos(scene, src);
+
+	obs_source_release(src);
+	obs_source_release(sceneSource);
+	return true;
+#else
+	LOGW("Frontend API not available; cannot add native scoreboard source.");
 	return false;
 #endif
-}
\ No newline at end of file
+}
+
+void fly_source_tracking_start()
+{
+	g_browserTracker.start();
+	g_nativeTracker.start();
+}
+
+void fly_source_tracking_stop()
+{
+	g_browserTracker.stop();
+	g_nativeTracker.stop();
+}
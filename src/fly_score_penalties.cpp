@@ -0,0 +1,190 @@
+#include "fly_score_penalties.hpp"
+
+#include <QDateTime>
+
+#include <algorithm>
+
+// Expiry resolution; well below what a mm:ss display can show
+static constexpr int64_t kPenaltyTickMs = 100;
+
+static int64_t default_wall_ms()
+{
+	return QDateTime::currentMSecsSinceEpoch();
+}
+
+FlyPenaltyClock::FlyPenaltyClock(ClockMs steadyMs, ClockMs wallMs)
+	: steadyMs_(steadyMs ? std::move(steadyMs) : ClockMs(&FlyTimerEngine::steadyNowMs)),
+	  wallMs_(wallMs ? std::move(wallMs) : ClockMs(default_wall_ms)),
+	  wheel_(kPenaltyTickMs, steadyMs_())
+{
+}
+
+void FlyPenaltyClock::load(const QVector<FlyPenalty> &penalties, bool running)
+{
+	const int64_t steadyNow = steadyMs_();
+	const int64_t wallNow = wallMs_();
+
+	wheel_.reset(steadyNow);
+	active_.clear();
+	counts_[0] = counts_[1] = 0;
+	running_ = running;
+
+	for (const FlyPenalty &p : penalties) {
+		Entry e;
+		e.penalty = p;
+
+		// Persisted while running: bridge the gap with the wall anchor
+		int64_t remaining = std::max<int64_t>(0, p.remaining_ms);
+		if (p.running && p.last_tick_ms > 0)
+			remaining = std::max<int64_t>(0, remaining - std::max<int64_t>(0, wallNow - p.last_tick_ms));
+
+		e.penalty.remaining_ms = remaining;
+		e.penalty.id = p.id ? p.id : nextId_;
+		nextId_ = std::max(nextId_, e.penalty.id + 1);
+
+		if (running_)
+			arm(e, steadyNow);
+
+		active_.insert(e.penalty.id, e);
+		countChanged(e.penalty.side, +1);
+	}
+}
+
+QVector<FlyPenalty> FlyPenaltyClock::snapshot() const
+{
+	const int64_t steadyNow = steadyMs_();
+	const int64_t wallNow = wallMs_();
+
+	QVector<FlyPenalty> out;
+	out.reserve(active_.size());
+
+	for (const Entry &e : active_) {
+		FlyPenalty p = e.penalty;
+		p.running = running_;
+		p.remaining_ms = remainingMs(e, steadyNow);
+		p.last_tick_ms = running_ ? wallNow : 0;
+		out.push_back(std::move(p));
+	}
+
+	std::sort(out.begin(), out.end(), [](const FlyPenalty &a, const FlyPenalty &b) {
+		return a.remaining_ms != b.remaining_ms ? a.remaining_ms < b.remaining_ms : a.id < b.id;
+	});
+	return out;
+}
+
+int64_t FlyPenaltyClock::remainingMs(const Entry &e, int64_t steadyNow) const
+{
+	if (!running_)
+		return e.penalty.remaining_ms;
+	return std::max<int64_t>(0, e.dueSteadyMs - steadyNow);
+}
+
+void FlyPenaltyClock::arm(Entry &e, int64_t steadyNow)
+{
+	e.dueSteadyMs = steadyNow + e.penalty.remaining_ms;
+	e.handle = wheel_.schedule(e.dueSteadyMs, e.penalty.id);
+}
+
+void FlyPenaltyClock::countChanged(FlyFieldSide side, int delta)
+{
+	int &c = counts_[side == FlyFieldSide::Away ? 1 : 0];
+	c = std::max(0, c + delta);
+}
+
+quint32 FlyPenaltyClock::add(FlyFieldSide side, int64_t durationMs, const QString &label)
+{
+	Entry e;
+	e.penalty.id = nextId_++;
+	e.penalty.side = side;
+	e.penalty.label = label;
+	e.penalty.duration_ms = std::max<int64_t>(0, durationMs);
+	e.penalty.remaining_ms = e.penalty.duration_ms;
+
+	if (running_)
+		arm(e, steadyMs_());
+
+	active_.insert(e.penalty.id, e);
+	countChanged(side, +1);
+	return e.penalty.id;
+}
+
+bool FlyPenaltyClock::remove(quint32 id)
+{
+	auto it = active_.find(id);
+	if (it == active_.end())
+		return false;
+
+	if (it->handle)
+		wheel_.cancel(it->handle);
+
+	countChanged(it->penalty.side, -1);
+	active_.erase(it);
+	return true;
+}
+
+quint32 FlyPenaltyClock::soonest(FlyFieldSide side) const
+{
+	const int64_t steadyNow = steadyMs_();
+
+	quint32 best = 0;
+	int64_t bestMs = 0;
+	for (const Entry &e : active_) {
+		if (e.penalty.side != side)
+			continue;
+
+		const int64_t ms = remainingMs(e, steadyNow);
+		if (!best || ms < bestMs || (ms == bestMs && e.penalty.id < best)) {
+			best = e.penalty.id;
+			bestMs = ms;
+		}
+	}
+	return best;
+}
+
+bool FlyPenaltyClock::setRunning(bool running)
+{
+	if (running_ == running)
+		return false;
+
+	const int64_t steadyNow = steadyMs_();
+
+	if (running) {
+		wheel_.reset(steadyNow);
+		running_ = true;
+		for (Entry &e : active_)
+			arm(e, steadyNow);
+	} else {
+		// Freeze the remaining time; the wheel is rebuilt on resume
+		for (Entry &e : active_) {
+			e.penalty.remaining_ms = remainingMs(e, steadyNow);
+			e.handle = 0;
+		}
+		running_ = false;
+		wheel_.reset(steadyNow);
+	}
+	return true;
+}
+
+QVector<FlyPenalty> FlyPenaltyClock::advance()
+{
+	QVector<FlyPenalty> expired;
+	if (!running_ || active_.isEmpty())
+		return expired;
+
+	wheel_.advance(steadyMs_(), [this, &expired](uint64_t payload, int64_t) {
+		auto it = active_.find(static_cast<quint32>(payload));
+		if (it == active_.end())
+			return;
+
+		FlyPenalty p = it->penalty;
+		p.remaining_ms = 0;
+		p.running = false;
+		p.last_tick_ms = 0;
+
+		countChanged(p.side, -1);
+		active_.erase(it);
+		expired.push_back(std::move(p));
+	});
+
+	return expired;
+}
@@ -0,0 +1,163 @@
+#include "config.hpp"
+
+#define LOG_TAG "[" PLUGIN_NAME "][persist]"
+#include "fly_score_log.hpp"
+
+#include "fly_score_persist.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+// Writes slower than this are worth a line in the OBS log.
+static constexpr int64_t kSlowWriteUs = 250 * 1000;
+
+static int64_t steady_now_us()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+FlyStatePersister::FlyStatePersister(int coalesceMs) : coalesceMs_(std::max(0, coalesceMs))
+{
+	worker_ = std::thread([this]() { run(); });
+}
+
+FlyStatePersister::~FlyStatePersister()
+{
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+
+	if (worker_.joinable())
+		worker_.join();
+}
+
+void FlyStatePersister::setCoalesceWindowMs(int ms)
+{
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		coalesceMs_ = std::max(0, ms);
+	}
+	cv_.notify_all();
+}
+
+int FlyStatePersister::coalesceWindowMs() const
+{
+	std::lock_guard<std::mutex> lk(mtx_);
+	return coalesceMs_;
+}
+
+void FlyStatePersister::submit(const QString &baseDir, const FlyState &st, int64_t originUs)
+{
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		++stats_.submitted;
+
+		// Latest wins: replace the queued snapshot for the same file, but keep
+		// its original submit time so a steady stream cannot starve the write.
+		if (!queue_.empty() && queue_.back().baseDir == baseDir) {
+			queue_.back().state = st;
+			if (!queue_.back().originUs)
+				queue_.back().originUs = originUs;
+			++stats_.coalesced;
+			return;
+		}
+
+		Job job;
+		job.baseDir = baseDir;
+		job.state = st;
+		job.firstSubmitUs = steady_now_us();
+		job.originUs = originUs;
+		queue_.push_back(std::move(job));
+		stats_.queue_depth = static_cast<int>(queue_.size());
+	}
+	cv_.notify_one();
+}
+
+void FlyStatePersister::flush()
+{
+	std::unique_lock<std::mutex> lk(mtx_);
+	if (queue_.empty() && !writing_)
+		return;
+
+	flushRequested_ = true;
+	cv_.notify_all();
+	idleCv_.wait(lk, [this]() { return queue_.empty() && !writing_; });
+}
+
+FlyStatePersister::Stats FlyStatePersister::stats() const
+{
+	std::lock_guard<std::mutex> lk(mtx_);
+	return stats_;
+}
+
+int64_t FlyStatePersister::nowUs()
+{
+	return steady_now_us();
+}
+
+void FlyStatePersister::run()
+{
+	std::unique_lock<std::mutex> lk(mtx_);
+
+	for (;;) {
+		if (queue_.empty()) {
+			flushRequested_ = false;
+			idleCv_.notify_all();
+
+			if (stop_)
+				break;
+
+			cv_.wait(lk, [this]() { return stop_ || !queue_.empty(); });
+			continue;
+		}
+
+		if (!flushRequested_ && !stop_) {
+			const int64_t dueUs = queue_.front().firstSubmitUs + int64_t(coalesceMs_) * 1000;
+			const int64_t nowUs = steady_now_us();
+			if (nowUs < dueUs) {
+				cv_.wait_for(lk, std::chrono::microseconds(dueUs - nowUs));
+				continue;
+			}
+		}
+
+		Job job = std::move(queue_.front());
+		queue_.pop_front();
+		stats_.queue_depth = static_cast<int>(queue_.size());
+		writing_ = true;
+
+		lk.unlock();
+		const int64_t t0 = steady_now_us();
+		const QByteArray json = fly_state_serialize(job.state);
+		const int64_t t1 = steady_now_us();
+		const bool ok = fly_state_save_serialized(job.baseDir, json);
+		const int64_t t2 = steady_now_us();
+		const int64_t dt = t2 - t0;
+		lk.lock();
+
+		writing_ = false;
+		if (ok) {
+			++stats_.written;
+			stats_.bytes_written += uint64_t(json.size());
+			if (job.originUs) {
+				stats_.last_origin_latency_us = t2 - job.originUs;
+				stats_.max_origin_latency_us =
+					std::max(stats_.max_origin_latency_us, stats_.last_origin_latency_us);
+			}
+		} else {
+			++stats_.failed;
+		}
+		stats_.last_write_us = dt;
+		stats_.max_write_us = std::max(stats_.max_write_us, dt);
+		stats_.serialize_us_total += t1 - t0;
+		stats_.write_us_total += t2 - t1;
+
+		if (!ok)
+			LOGW("Failed to write plugin.json in %s", job.baseDir.toUtf8().constData());
+		else if (dt > kSlowWriteUs)
+			LOGW("Slow plugin.json write: %lld ms (queue depth %d)", (long long)(dt / 1000),
+			     stats_.queue_depth);
+	}
+}
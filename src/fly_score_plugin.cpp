@@ -13,6 +13,9 @@
 #include "fly_score_state.hpp"
 #include "fly_score_dock.hpp"
 #include "fly_score_const.hpp"
+#include "fly_score_native_source.hpp"
+#include "fly_score_obs_helpers.hpp"
+#include "fly_score_core_log.hpp"
 
 OBS_DECLARE_MODULE();
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
@@ -27,10 +30,19 @@ MODULE_EXPORT const char *obs_module_description(void)
 	return "Fly Scoreboard real-time sports/e-sports streaming scoreboard plugin and overlay.";
 }
 
+// fly_score_core logs through this, so its lines land in the OBS log too
+static void fly_core_to_blog(int level, const char *msg)
+{
+	blog(level, "%s", msg);
+}
+
 bool obs_module_load(void)
 {
+	fly_core_set_log_handler(fly_core_to_blog);
 	LOGI("Plugin loaded (version %s)", PLUGIN_VERSION);
 
+	fly_register_native_source();
+	fly_source_tracking_start();
 	fly_create_dock();
 
 	return true;
@@ -41,5 +53,7 @@ void obs_module_unload(void)
 	LOGI("Plugin unloading...");
 
 	fly_destroy_dock();
+	fly_source_tracking_stop();
+	fly_core_set_log_handler(nullptr);
 	LOGI("Plugin unloaded");
 }
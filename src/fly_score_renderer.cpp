@@ -0,0 +1,326 @@
+#include "fly_score_renderer.hpp"
+
+#include "fly_score_frame_clock.hpp"
+
+#include <QColor>
+#include <QDir>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPainterPath>
+#include <QRect>
+#include <QStringList>
+
+#include <algorithm>
+
+// Geometry of the default overlay (style.css), in pixels
+static constexpr int kPad = 30;
+static constexpr int kBarW = 750;
+static constexpr int kBarH = 72;
+static constexpr int kCenterW = 140;
+static constexpr int kDetailsH = 30;
+static constexpr int kTeamPad = 20;
+static constexpr int kStripeW = 6;
+static constexpr int kScoreW = 60;
+static constexpr int kLogoW = 50;
+static constexpr int kLogoH = 42;
+static constexpr int kLogoGap = 15;
+static constexpr int kRadius = 6;
+
+static const QColor kBgMain(12, 12, 12, 235);
+static const QColor kBgCenter(0x1a, 0x1a, 0x1a);
+static const QColor kLine(255, 255, 255, 25);
+static const QColor kTextWhite(255, 255, 255);
+static const QColor kTextDim(0xa0, 0xa0, 0xa0);
+static const QColor kClockAmber(0xff, 0xb7, 0x03);
+static const QColor kClockAlarm(0xff, 0x6b, 0x35);
+static const QColor kClockUrgent(0xff, 0x3b, 0x3b);
+
+static QFont fly_font(int px, QFont::Weight weight)
+{
+	QFont f(QStringLiteral("Inter"));
+	f.setStyleHint(QFont::SansSerif);
+	f.setPixelSize(px);
+	f.setWeight(weight);
+	return f;
+}
+
+static void fly_draw_text(QPainter &p, const QRect &r, int flags, const QFont &font, const QColor &color,
+			  const QString &text)
+{
+	p.setFont(font);
+	p.setPen(color);
+	p.drawText(r, flags, QFontMetrics(font).elidedText(text, Qt::ElideRight, r.width()));
+}
+
+// 0 = none, 1 = inside a threshold, 2 = tightest threshold or expired
+// (the same levels as the overlay's is-alarm / alarm-0 / is-expired)
+static int fly_alarm_level(const FlyTimer &t, int64_t ms, const FlyAlarmConfig &alarms)
+{
+	if (t.mode != FlyTimerMode::Countdown || alarms.thresholds_ms.isEmpty())
+		return 0;
+
+	QVector<long long> positive;
+	bool hasZero = false;
+	for (long long v : alarms.thresholds_ms) {
+		if (v > 0)
+			positive.push_back(v);
+		else if (v == 0)
+			hasZero = true;
+	}
+	std::sort(positive.begin(), positive.end());
+
+	if (ms <= 0)
+		return hasZero ? 2 : 0;
+	for (int i = 0; i < positive.size(); ++i) {
+		if (ms <= positive[i])
+			return i == 0 ? 2 : 1;
+	}
+	return 0;
+}
+
+FlyScoreRenderer::FlyScoreRenderer(int width, int height) : width_(width), height_(height) {}
+
+void FlyScoreRenderer::setDocRoot(const QString &docRoot)
+{
+	if (docRoot_ == docRoot)
+		return;
+
+	docRoot_ = docRoot;
+	logos_.clear();
+	staticKey_.clear();
+	dynamicKey_.clear();
+}
+
+const QImage &FlyScoreRenderer::logo(const QString &rel)
+{
+	const QString path = QDir::isAbsolutePath(rel) ? rel : QDir(docRoot_).filePath(rel);
+
+	auto it = logos_.find(path);
+	if (it == logos_.end()) {
+		QImage img(path);
+		if (!img.isNull())
+			img = img.scaled(kLogoW, kLogoH, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+				      .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+		it = logos_.insert(path, img);
+	}
+	return *it;
+}
+
+void FlyScoreRenderer::rebuildStaticLayer(const FlyState &st)
+{
+	const FlyTeam &left = st.swap_sides ? st.away : st.home;
+	const FlyTeam &right = st.swap_sides ? st.home : st.away;
+
+	staticLayer_ = QImage(width_, height_, QImage::Format_ARGB32_Premultiplied);
+	staticLayer_.fill(Qt::transparent);
+
+	QPainter p(&staticLayer_);
+	p.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+
+	const QRect bar((width_ - kBarW) / 2, kPad, kBarW, kBarH);
+	const int teamW = (kBarW - kCenterW) / 2;
+	const QRect leftRect(bar.x(), bar.y(), teamW, kBarH);
+	const QRect centerRect(leftRect.right() + 1, bar.y(), kCenterW, kBarH);
+	const QRect rightRect(centerRect.right() + 1, bar.y(), teamW, kBarH);
+
+	// Bar background, rounded on top only
+	QPainterPath bg;
+	bg.addRoundedRect(QRectF(bar), kRadius, kRadius);
+	bg.addRect(QRectF(bar.x(), bar.bottom() - kRadius, bar.width(), kRadius + 1));
+	bg.setFillRule(Qt::WindingFill);
+	p.fillPath(bg.simplified(), kBgMain);
+	p.fillRect(centerRect, kBgCenter);
+	p.fillRect(QRect(centerRect.x(), centerRect.y(), 1, kBarH), kLine);
+	p.fillRect(QRect(centerRect.right(), centerRect.y(), 1, kBarH), kLine);
+
+	p.fillRect(QRect(leftRect.x(), leftRect.y(), kStripeW, kBarH), QColor(QRgb(0xFF000000u | left.color)));
+	p.fillRect(QRect(rightRect.right() - kStripeW + 1, rightRect.y(), kStripeW, kBarH),
+		   QColor(QRgb(0xFF000000u | right.color)));
+
+	const QFont abbrFont = fly_font(24, QFont::Black);
+	const QFont nameFont = fly_font(10, QFont::Bold);
+
+	// Left: [stripe] logo meta ........ score
+	{
+		int x = leftRect.x() + kTeamPad;
+		if (!left.logo.isEmpty()) {
+			const QImage &img = logo(left.logo);
+			if (!img.isNull()) {
+				p.drawImage(QPoint(x + (kLogoW - img.width()) / 2, leftRect.y() + (kBarH - img.height()) / 2),
+					    img);
+				x += kLogoW + kLogoGap;
+			}
+		}
+		const int metaRight = leftRect.right() - kTeamPad - kScoreW;
+		const QRect meta(x, leftRect.y() + 14, std::max(0, metaRight - x), kBarH - 28);
+		fly_draw_text(p, QRect(meta.x(), meta.y(), meta.width(), 26), Qt::AlignLeft | Qt::AlignVCenter,
+			      abbrFont, kTextWhite, left.subtitle);
+		fly_draw_text(p, QRect(meta.x(), meta.y() + 28, meta.width(), 14), Qt::AlignLeft | Qt::AlignVCenter,
+			      nameFont, kTextDim, left.title.toUpper());
+	}
+
+	// Right: score ........ meta logo [stripe]
+	{
+		int x = rightRect.right() - kTeamPad;
+		if (!right.logo.isEmpty()) {
+			const QImage &img = logo(right.logo);
+			if (!img.isNull()) {
+				p.drawImage(QPoint(x - kLogoW + (kLogoW - img.width()) / 2,
+						   rightRect.y() + (kBarH - img.height()) / 2),
+					    img);
+				x -= kLogoW + kLogoGap;
+			}
+		}
+		const int metaLeft = rightRect.x() + kTeamPad + kScoreW;
+		const QRect meta(metaLeft, rightRect.y() + 14, std::max(0, x - metaLeft), kBarH - 28);
+		fly_draw_text(p, QRect(meta.x(), meta.y(), meta.width(), 26), Qt::AlignRight | Qt::AlignVCenter,
+			      abbrFont, kTextWhite, right.subtitle);
+		fly_draw_text(p, QRect(meta.x(), meta.y() + 28, meta.width(), 14), Qt::AlignRight | Qt::AlignVCenter,
+			      nameFont, kTextDim, right.title.toUpper());
+	}
+
+	p.setPen(kLine);
+	p.setBrush(Qt::NoBrush);
+	p.drawRoundedRect(QRectF(bar).adjusted(0.5, 0.5, -0.5, -0.5), kRadius, kRadius);
+}
+
+bool FlyScoreRenderer::timerDrawn(const FlyState &st, int index)
+{
+	if (index < 0 || index >= kRenderedTimers || index >= st.timers.size() || !st.timers[index].visible)
+		return false;
+	if (index == 0)
+		return true;
+
+	// The second timer lives in the details row, which only exists while
+	// the third field is visible
+	return st.custom_fields.size() > 2 && st.custom_fields[2].visible;
+}
+
+bool FlyScoreRenderer::update(const FlyState &st, const QVector<int64_t> &timerMs)
+{
+	const QString sep = QStringLiteral("\x1f");
+
+	// Static inputs: anything painted into staticLayer_
+	const FlyTeam &left = st.swap_sides ? st.away : st.home;
+	const FlyTeam &right = st.swap_sides ? st.home : st.away;
+	const QString staticKey = QStringList{left.title,    left.subtitle,  left.logo,
+					      QString::number(left.color),   right.title,
+					      right.subtitle, right.logo, QString::number(right.color)}
+					  .join(sep);
+
+	// Dynamic inputs: exactly the text drawn on top of it
+	auto fieldAt = [&st](int i) -> const FlyCustomField * {
+		return i < st.custom_fields.size() ? &st.custom_fields[i] : nullptr;
+	};
+	auto xOf = [&st](const FlyCustomField *f) { return f ? (st.swap_sides ? f->away : f->home) : 0; };
+	auto yOf = [&st](const FlyCustomField *f) { return f ? (st.swap_sides ? f->home : f->away) : 0; };
+
+	const FlyCustomField *score = fieldAt(0);
+	const FlyCustomField *period = (fieldAt(1) && fieldAt(1)->visible) ? fieldAt(1) : nullptr;
+	const FlyCustomField *detail = (fieldAt(2) && fieldAt(2)->visible) ? fieldAt(2) : nullptr;
+
+	QString timerText[kRenderedTimers];
+	int alarm[kRenderedTimers] = {};
+	bool timerShown[kRenderedTimers] = {};
+	for (int i = 0; i < kRenderedTimers; ++i) {
+		if (!timerDrawn(st, i))
+			continue;
+		const int64_t ms = i < timerMs.size() ? timerMs[i] : st.timers[i].remaining_ms;
+		timerShown[i] = true;
+		timerText[i] = FlyFrameClock::formatMs(ms, 0);
+		alarm[i] = fly_alarm_level(st.timers[i], ms, st.alarms);
+	}
+
+	QStringList dyn;
+	dyn << QString::number(st.show_scoreboard) << QString::number(xOf(score)) << QString::number(yOf(score));
+	dyn << (period ? QString::number(xOf(period)) : QString());
+	dyn << (detail ? QStringLiteral("%1 %2 %3").arg(detail->label).arg(xOf(detail)).arg(yOf(detail)) : QString());
+	for (int i = 0; i < kRenderedTimers; ++i)
+		dyn << (timerShown[i] ? QStringLiteral("%1 %2 %3").arg(st.timers[i].label, timerText[i]).arg(alarm[i])
+				      : QString());
+	const QString dynamicKey = dyn.join(sep);
+
+	if (staticKey == staticKey_ && dynamicKey == dynamicKey_)
+		return false;
+
+	if (staticKey != staticKey_ || staticLayer_.isNull()) {
+		rebuildStaticLayer(st);
+		staticKey_ = staticKey;
+	}
+	dynamicKey_ = dynamicKey;
+
+	if (!st.show_scoreboard) {
+		frame_ = QImage();
+		return true;
+	}
+
+	QImage img = staticLayer_.copy();
+	{
+		QPainter p(&img);
+		p.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+
+		const QRect bar((width_ - kBarW) / 2, kPad, kBarW, kBarH);
+		const int teamW = (kBarW - kCenterW) / 2;
+		const QRect centerRect(bar.x() + teamW, bar.y(), kCenterW, kBarH);
+
+		const QFont scoreFont = fly_font(45, QFont::Black);
+		fly_draw_text(p, QRect(bar.x() + teamW - kTeamPad - kScoreW, bar.y(), kScoreW, kBarH), Qt::AlignCenter,
+			      scoreFont, kTextWhite, QString::number(xOf(score)));
+		fly_draw_text(p, QRect(centerRect.right() + 1 + kTeamPad, bar.y(), kScoreW, kBarH), Qt::AlignCenter,
+			      scoreFont, kTextWhite, QString::number(yOf(score)));
+
+		if (timerShown[0]) {
+			const QColor c = alarm[0] == 2 ? kClockUrgent : alarm[0] == 1 ? kClockAlarm : kClockAmber;
+			fly_draw_text(p, QRect(centerRect.x(), bar.y() + 8, kCenterW, 32), Qt::AlignCenter,
+				      fly_font(29, QFont::ExtraBold), c, timerText[0]);
+			fly_draw_text(p, QRect(centerRect.x(), bar.y() + 40, kCenterW, 12), Qt::AlignCenter,
+				      fly_font(10, QFont::Bold), kTextDim, st.timers[0].label.toUpper());
+		}
+
+		if (period) {
+			const QFont pillFont = fly_font(12, QFont::ExtraBold);
+			const QString text = QStringLiteral("PERIOD %1").arg(xOf(period));
+			const int w = QFontMetrics(pillFont).horizontalAdvance(text) + 16;
+			const QRect pill(centerRect.x() + (kCenterW - w) / 2, bar.y() + 54, w, 16);
+			p.setPen(Qt::NoPen);
+			p.setBrush(kLine);
+			p.drawRoundedRect(pill, 4, 4);
+			fly_draw_text(p, pill, Qt::AlignCenter, pillFont, kTextWhite, text);
+		}
+
+		if (detail) {
+			const QRect row(bar.x(), bar.bottom() + 1, kBarW, kDetailsH);
+			QPainterPath bg;
+			bg.addRoundedRect(QRectF(row), kRadius, kRadius);
+			bg.addRect(QRectF(row.x(), row.y(), row.width(), kRadius));
+			bg.setFillRule(Qt::WindingFill);
+			p.fillPath(bg.simplified(), kBgMain);
+
+			const QFont labelFont = fly_font(10, QFont::Bold);
+			const QFont valueFont = fly_font(13, QFont::ExtraBold);
+			int x = row.x() + kTeamPad;
+
+			auto chip = [&](const QString &label, const QString &value) {
+				const int lw = QFontMetrics(labelFont).horizontalAdvance(label);
+				const int vw = QFontMetrics(valueFont).horizontalAdvance(value);
+				fly_draw_text(p, QRect(x, row.y(), lw + 1, kDetailsH), Qt::AlignLeft | Qt::AlignVCenter,
+					      labelFont, kTextDim, label);
+				x += lw + 8;
+				fly_draw_text(p, QRect(x, row.y(), vw + 1, kDetailsH), Qt::AlignLeft | Qt::AlignVCenter,
+					      valueFont, kTextWhite, value);
+				x += vw + 24;
+			};
+
+			chip(detail->label.toUpper(),
+			     QStringLiteral("%1 — %2").arg(xOf(detail)).arg(yOf(detail)));
+			if (timerShown[1])
+				chip(st.timers[1].label.toUpper(), timerText[1]);
+		}
+	}
+
+	// OBS async frames are straight alpha
+	img.convertTo(QImage::Format_ARGB32);
+	frame_ = std::move(img);
+	return true;
+}
@@ -0,0 +1,592 @@
+#include "config.hpp"
+
+#define LOG_TAG "[" PLUGIN_NAME "][server]"
+#include "fly_score_log.hpp"
+
+#include "fly_score_server.hpp"
+#include "fly_score_assets.hpp"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QSet>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QUrl>
+#include <QUrlQuery>
+
+#include <utility>
+
+// Requests are tiny GETs; anything bigger is not for us.
+static constexpr int kMaxRequestBytes = 16 * 1024;
+
+// -----------------------------------------------------------------------------
+// HTTP helpers
+// -----------------------------------------------------------------------------
+
+struct FlyHttpRequest {
+	QByteArray method;
+	QString path;
+	QByteArray query;
+	QHash<QByteArray, QByteArray> headers; // lower-case names
+};
+
+static bool parse_request(const QByteArray &raw, FlyHttpRequest &out)
+{
+	const int headerEnd = raw.indexOf("\r\n\r\n");
+	if (headerEnd < 0)
+		return false;
+
+	const QList<QByteArray> lines = raw.left(headerEnd).split('\n');
+	if (lines.isEmpty())
+		return false;
+
+	const QList<QByteArray> reqLine = lines[0].trimmed().split(' ');
+	if (reqLine.size() < 2)
+		return false;
+
+	out.method = reqLine[0].toUpper();
+
+	QByteArray target = reqLine[1];
+	const int q = target.indexOf('?');
+	if (q >= 0) {
+		out.query = target.mid(q + 1);
+		target.truncate(q);
+	}
+	out.path = QUrl::fromPercentEncoding(target);
+
+	for (int i = 1; i < lines.size(); ++i) {
+		const QByteArray line = lines[i].trimmed();
+		const int colon = line.indexOf(':');
+		if (colon <= 0)
+			continue;
+		out.headers.insert(line.left(colon).trimmed().toLower(), line.mid(colon + 1).trimmed());
+	}
+	return true;
+}
+
+static QByteArray mime_for(const QString &path)
+{
+	const QString ext = QFileInfo(path).suffix().toLower();
+	if (ext == QLatin1String("html") || ext == QLatin1String("htm"))
+		return "text/html; charset=utf-8";
+	if (ext == QLatin1String("css"))
+		return "text/css; charset=utf-8";
+	if (ext == QLatin1String("js"))
+		return "application/javascript; charset=utf-8";
+	if (ext == QLatin1String("json"))
+		return "application/json; charset=utf-8";
+	if (ext == QLatin1String("png"))
+		return "image/png";
+	if (ext == QLatin1String("jpg") || ext == QLatin1String("jpeg"))
+		return "image/jpeg";
+	if (ext == QLatin1String("svg"))
+		return "image/svg+xml";
+	if (ext == QLatin1String("webp"))
+		return "image/webp";
+	if (ext == QLatin1String("gif"))
+		return "image/gif";
+	return "application/octet-stream";
+}
+
+static bool etag_matches(const QByteArray &ifNoneMatch, const QByteArray &etag)
+{
+	if (ifNoneMatch.isEmpty())
+		return false;
+	if (ifNoneMatch.trimmed() == "*")
+		return true;
+
+	for (QByteArray candidate : ifNoneMatch.split(',')) {
+		candidate = candidate.trimmed();
+		if (candidate.startsWith("W/"))
+			candidate = candidate.mid(2);
+		if (candidate == etag)
+			return true;
+	}
+	return false;
+}
+
+static const char *reason_for(int code)
+{
+	switch (code) {
+	case 200:
+		return "OK";
+	case 304:
+		return "Not Modified";
+	case 400:
+		return "Bad Request";
+	case 404:
+		return "Not Found";
+	case 405:
+		return "Method Not Allowed";
+	default:
+		return "Internal Server Error";
+	}
+}
+
+static QByteArray make_response(int code, const QByteArray &contentType, const QByteArray &body, bool headOnly,
+				const QByteArray &extraHeaders = QByteArray())
+{
+	QByteArray r;
+	r.reserve(256 + (headOnly ? 0 : body.size()));
+	r += "HTTP/1.1 " + QByteArray::number(code) + ' ' + reason_for(code) + "\r\n";
+	if (!contentType.isEmpty())
+		r += "Content-Type: " + contentType + "\r\n";
+	r += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+	r += extraHeaders;
+	r += "Connection: close\r\n\r\n";
+	if (!headOnly)
+		r += body;
+	return r;
+}
+
+// -----------------------------------------------------------------------------
+// Worker (lives on the server thread)
+// -----------------------------------------------------------------------------
+
+class FlyHttpWorker : public QObject {
+public:
+	explicit FlyHttpWorker(FlyHttpServer::Shared &shared) : shared_(shared) {}
+
+	bool listen(quint16 port)
+	{
+		server_ = new QTcpServer(this);
+		if (!server_->listen(QHostAddress::LocalHost, port)) {
+			LOGW("Cannot listen on 127.0.0.1:%u: %s", unsigned(port),
+			     server_->errorString().toUtf8().constData());
+			delete server_;
+			server_ = nullptr;
+			return false;
+		}
+
+		connect(server_, &QTcpServer::newConnection, this, [this]() { onNewConnection(); });
+		return true;
+	}
+
+	void shutdown()
+	{
+		// Sockets first: accepted ones are children of server_ and die with it.
+		// abort() emits disconnected, whose handler edits buffers_ and sse_.
+		sse_.clear();
+		const auto sockets = buffers_.keys();
+		buffers_.clear();
+		for (QTcpSocket *s : sockets)
+			s->abort();
+
+		if (server_) {
+			server_->close();
+			delete server_;
+			server_ = nullptr;
+		}
+	}
+
+	// Called (queued) after publish(); sends the latest state to every SSE client
+	void pushState()
+	{
+		// /state polls and new streams also refresh(), so the revision may have
+		// advanced before we got here; what matters is what the streams have seen
+		refresh();
+		if (sse_.isEmpty() || history_.revision() <= lastPushedRev_)
+			return;
+
+		// Streams are in lock-step at lastPushedRev_; one patch catches them all up
+		const QByteArray patch = patchJson(lastPushedRev_);
+		const QByteArray msg = patch.isEmpty() ? eventMessage("state", stateBytes_)
+						       : eventMessage("patch", patch);
+		for (QTcpSocket *s : std::as_const(sse_))
+			s->write(msg);
+		lastPushedRev_ = history_.revision();
+	}
+
+	// Called (queued) from resync(): full state, then ask pages to reload images
+	void pushResync()
+	{
+		if (sse_.isEmpty())
+			return;
+
+		refresh();
+		const QByteArray msg = eventMessage("state", stateBytes_) + "event: resync\ndata: {}\n\n";
+		for (QTcpSocket *s : std::as_const(sse_))
+			s->write(msg);
+		lastPushedRev_ = history_.revision();
+	}
+
+	// Called (queued) after publishFrame(); frames carry no revision id
+	void pushFrame()
+	{
+		if (sse_.isEmpty())
+			return;
+
+		QByteArray frame;
+		{
+			QMutexLocker lk(&shared_.mtx);
+			frame = shared_.frame;
+		}
+		if (frame.isEmpty())
+			return;
+
+		const QByteArray msg = "event: frame\ndata: " + frame + "\n\n";
+		for (QTcpSocket *s : std::as_const(sse_))
+			s->write(msg);
+	}
+
+private:
+	void onNewConnection()
+	{
+		while (QTcpSocket *s = server_->nextPendingConnection()) {
+			buffers_.insert(s, QByteArray());
+			connect(s, &QTcpSocket::readyRead, this, [this, s]() { onReadyRead(s); });
+			connect(s, &QTcpSocket::disconnected, this, [this, s]() {
+				buffers_.remove(s);
+				sse_.remove(s);
+				s->deleteLater();
+			});
+		}
+	}
+
+	void onReadyRead(QTcpSocket *s)
+	{
+		if (sse_.contains(s)) {
+			s->readAll(); // event streams are one-way
+			return;
+		}
+
+		auto it = buffers_.find(s);
+		if (it == buffers_.end())
+			return;
+
+		it.value() += s->readAll();
+		if (it.value().size() > kMaxRequestBytes) {
+			reply(s, make_response(400, "text/plain", "Request too large", false));
+			return;
+		}
+
+		FlyHttpRequest req;
+		if (!parse_request(it.value(), req))
+			return; // wait for the rest of the headers
+
+		it.value().clear();
+		handle(s, req);
+	}
+
+	void reply(QTcpSocket *s, const QByteArray &response)
+	{
+		s->write(response);
+		s->disconnectFromHost();
+	}
+
+	void handle(QTcpSocket *s, const FlyHttpRequest &req)
+	{
+		const bool head = req.method == "HEAD";
+		if (req.method != "GET" && !head) {
+			reply(s, make_response(405, "text/plain", "Method Not Allowed", false, "Allow: GET, HEAD\r\n"));
+			return;
+		}
+
+		if (req.path == QLatin1String("/events") && !head) {
+			openEventStream(s, req.headers.value("last-event-id").toULongLong());
+			return;
+		}
+
+		if (req.path == QLatin1String("/ack")) {
+			handleProbeAck(s, req, head);
+			return;
+		}
+
+		if (req.path == QLatin1String("/state") || req.path == QLatin1String("/plugin.json")) {
+			// /state?since=N answers with a patch when N is still in the ring
+			refresh();
+			const quint64 since = QUrlQuery(QString::fromLatin1(req.query))
+						      .queryItemValue(QStringLiteral("since"))
+						      .toULongLong();
+			QByteArray body = since ? patchJson(since) : QByteArray();
+			if (body.isEmpty())
+				body = stateBytes_;
+
+			reply(s, make_response(200, "application/json; charset=utf-8", body, head,
+					       "Cache-Control: no-store\r\n"));
+			return;
+		}
+
+		QString rel = req.path;
+		if (rel.isEmpty() || rel == QLatin1String("/"))
+			rel = QStringLiteral("/index.html");
+
+		FlyAsset asset;
+		if (!lookupAsset(rel, asset)) {
+			reply(s, make_response(404, "text/plain", "Not Found", head));
+			return;
+		}
+
+		// no-cache = always revalidate; a matching ETag costs one tiny 304
+		const QByteArray validators = "ETag: " + asset.etag + "\r\nCache-Control: no-cache\r\n";
+		if (etag_matches(req.headers.value("if-none-match"), asset.etag)) {
+			reply(s, make_response(304, QByteArray(), QByteArray(), true, validators));
+			return;
+		}
+
+		reply(s, make_response(200, mime_for(rel), asset.data, head, validators));
+	}
+
+	// The overlay applied (and painted) a probe-stamped version
+	void handleProbeAck(QTcpSocket *s, const FlyHttpRequest &req, bool head)
+	{
+		const QUrlQuery q(QString::fromLatin1(req.query));
+		const QString via = q.queryItemValue(QStringLiteral("via"));
+
+		bool okSent = false;
+		bool okApplied = false;
+		const qint64 sent = q.queryItemValue(QStringLiteral("sent")).toLongLong(&okSent);
+		const qint64 applied = q.queryItemValue(QStringLiteral("applied")).toLongLong(&okApplied);
+
+		const bool knownVia = via == QLatin1String("push") || via == QLatin1String("poll") ||
+				      via == QLatin1String("file");
+		if (!okSent || !okApplied || !knownVia) {
+			reply(s, make_response(400, "text/plain", "Bad probe ack", head));
+			return;
+		}
+
+		shared_.latency.record(via, applied - sent);
+		reply(s, make_response(200, "text/plain", QByteArray(), head, "Cache-Control: no-store\r\n"));
+	}
+
+	void openEventStream(QTcpSocket *s, quint64 lastEventId)
+	{
+		// Bring the open streams up to date first: the new one starts at the
+		// current revision, and from here on all of them move in lock-step
+		pushState();
+		const QByteArray patch = lastEventId ? patchJson(lastEventId) : QByteArray();
+
+		QByteArray r;
+		r += "HTTP/1.1 200 OK\r\n";
+		r += "Content-Type: text/event-stream\r\n";
+		r += "Cache-Control: no-store\r\n";
+		r += "Connection: keep-alive\r\n\r\n";
+		// Reconnect quickly if OBS restarts the server. A reconnecting client that is
+		// only a few revisions behind gets a patch; everyone else the full state.
+		r += "retry: 1000\n";
+		r += patch.isEmpty() ? eventMessage("state", stateBytes_) : eventMessage("patch", patch);
+
+		s->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+		s->write(r);
+		sse_.insert(s);
+		lastPushedRev_ = history_.revision();
+	}
+
+	// Pull the newest published snapshot into the history.
+	// Returns true when it produced a new revision.
+	bool refresh()
+	{
+		FlyState snapshot;
+		{
+			QMutexLocker lk(&shared_.mtx);
+			if (shared_.version == seenVersion_)
+				return false;
+			seenVersion_ = shared_.version;
+			snapshot = shared_.state;
+		}
+
+		const quint64 before = history_.revision();
+		if (history_.commit(snapshot) == before)
+			return false;
+
+		QJsonObject full = history_.current();
+		full["rev"] = double(history_.revision());
+		stateBytes_ = QJsonDocument(full).toJson(QJsonDocument::Compact);
+		return true;
+	}
+
+	QByteArray stateJson()
+	{
+		refresh();
+		return stateBytes_;
+	}
+
+	// {"from":N,"to":M,"ops":[...]}, or empty if `since` is too old to patch
+	QByteArray patchJson(quint64 since)
+	{
+		FlyStatePatch ops;
+		if (!history_.patchesSince(since, ops))
+			return QByteArray();
+
+		QJsonObject o;
+		o["from"] = double(since);
+		o["to"] = double(history_.revision());
+		o["ops"] = fly_state_patch_to_json(ops);
+		return QJsonDocument(o).toJson(QJsonDocument::Compact);
+	}
+
+	QByteArray eventMessage(const char *event, const QByteArray &data) const
+	{
+		return "id: " + QByteArray::number(history_.revision()) + "\nevent: " + event + "\ndata: " + data +
+		       "\n\n";
+	}
+
+	bool lookupAsset(const QString &rel, FlyAsset &out)
+	{
+		QString root;
+		{
+			QMutexLocker lk(&shared_.mtx);
+			root = shared_.docRoot;
+		}
+		assets_.setRoot(root);
+		return assets_.lookup(rel, out);
+	}
+
+	FlyHttpServer::Shared &shared_;
+	QTcpServer *server_ = nullptr;
+	QHash<QTcpSocket *, QByteArray> buffers_;
+	QSet<QTcpSocket *> sse_;
+	FlyAssetStore assets_;
+
+	quint64 seenVersion_ = ~quint64(0);
+	FlyStateHistory history_;
+	QByteArray stateBytes_;
+	quint64 lastPushedRev_ = 0; // revision every open event stream has
+};
+
+// -----------------------------------------------------------------------------
+// FlyHttpServer
+// -----------------------------------------------------------------------------
+
+FlyHttpServer::FlyHttpServer(QObject *parent) : QObject(parent) {}
+
+FlyHttpServer::~FlyHttpServer()
+{
+	stop();
+}
+
+bool FlyHttpServer::start(const QString &docRoot, quint16 port)
+{
+	stop();
+	setDocRoot(docRoot);
+
+	thread_ = new QThread();
+	thread_->setObjectName(QStringLiteral("fly-score-http"));
+
+	auto *worker = new FlyHttpWorker(shared_);
+	worker->moveToThread(thread_);
+	connect(thread_, &QThread::finished, worker, &QObject::deleteLater);
+	thread_->start();
+
+	bool ok = false;
+	QMetaObject::invokeMethod(worker, [worker, port, &ok]() { ok = worker->listen(port); },
+				  Qt::BlockingQueuedConnection);
+
+	if (!ok) {
+		thread_->quit();
+		thread_->wait();
+		delete thread_;
+		thread_ = nullptr;
+		return false;
+	}
+
+	worker_ = worker;
+	port_ = port;
+	{
+		QMutexLocker lk(&shared_.mtx);
+		shared_.worker = worker;
+	}
+	LOGI("Overlay server listening on %s", overlayUrl().toUtf8().constData());
+	return true;
+}
+
+void FlyHttpServer::stop()
+{
+	if (!thread_)
+		return;
+
+	{
+		QMutexLocker lk(&shared_.mtx);
+		shared_.worker = nullptr;
+		shared_.frame.clear();
+	}
+
+	if (worker_) {
+		FlyHttpWorker *w = worker_;
+		QMetaObject::invokeMethod(w, [w]() { w->shutdown(); }, Qt::BlockingQueuedConnection);
+	}
+
+	thread_->quit();
+	thread_->wait();
+	delete thread_;
+	thread_ = nullptr;
+	worker_ = nullptr;
+	port_ = 0;
+	pushPending_.store(false);
+	framePending_.store(false);
+
+	LOGI("Overlay server stopped");
+}
+
+QString FlyHttpServer::overlayUrl() const
+{
+	if (!isRunning())
+		return QString();
+	return QStringLiteral("http://127.0.0.1:%1/index.html").arg(port_);
+}
+
+QString FlyHttpServer::probeAckUrl() const
+{
+	if (!isRunning())
+		return QString();
+	return QStringLiteral("http://127.0.0.1:%1/ack").arg(port_);
+}
+
+void FlyHttpServer::setDocRoot(const QString &docRoot)
+{
+	QMutexLocker lk(&shared_.mtx);
+	shared_.docRoot = docRoot;
+}
+
+void FlyHttpServer::publish(const FlyState &st)
+{
+	{
+		QMutexLocker lk(&shared_.mtx);
+		shared_.state = st;
+		++shared_.version;
+	}
+
+	// One queued push per burst; the worker always sends the newest snapshot
+	if (!worker_ || pushPending_.exchange(true))
+		return;
+
+	FlyHttpWorker *w = worker_;
+	QMetaObject::invokeMethod(
+		w,
+		[this, w]() {
+			pushPending_.store(false);
+			w->pushState();
+		},
+		Qt::QueuedConnection);
+}
+
+void FlyHttpServer::resync()
+{
+	if (!worker_)
+		return;
+
+	FlyHttpWorker *w = worker_;
+	QMetaObject::invokeMethod(w, [w]() { w->pushResync(); }, Qt::QueuedConnection);
+}
+
+void FlyHttpServer::publishFrame(const QByteArray &json)
+{
+	QMutexLocker lk(&shared_.mtx);
+	shared_.frame = json;
+
+	if (!shared_.worker || framePending_.exchange(true))
+		return;
+
+	FlyHttpWorker *w = shared_.worker;
+	QMetaObject::invokeMethod(
+		w,
+		[this, w]() {
+			framePending_.store(false);
+			w->pushFrame();
+		},
+		Qt::QueuedConnection);
+}
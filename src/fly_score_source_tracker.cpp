@@ -0,0 +1,319 @@
+#include "fly_score_source_tracker.hpp"
+
+#include "config.hpp"
+#define LOG_TAG "[" PLUGIN_NAME "][source-tracker]"
+#include "fly_score_log.hpp"
+
+#ifdef ENABLE_FRONTEND_API
+#include <obs-frontend-api.h>
+#endif
+
+#include <QVector>
+
+#include <cstring>
+
+#ifdef ENABLE_FRONTEND_API
+static void fly_tracker_frontend_event(enum obs_frontend_event event, void *param)
+{
+	switch (event) {
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+	case OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED:
+		static_cast<FlySourceTracker *>(param)->invalidate();
+		break;
+	default:
+		break;
+	}
+}
+#endif
+
+static obs_scene_t *fly_scene_or_group(obs_source_t *src)
+{
+	obs_scene_t *scene = obs_scene_from_source(src);
+	return scene ? scene : obs_group_from_source(src);
+}
+
+FlySourceTracker::FlySourceTracker(const char *id, const char *name) : id_(id), name_(name) {}
+
+FlySourceTracker::~FlySourceTracker()
+{
+	stop();
+}
+
+void FlySourceTracker::start()
+{
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		if (started_)
+			return;
+		started_ = true;
+		stale_ = true;
+	}
+
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "source_create", &FlySourceTracker::onSourceCreate, this);
+	signal_handler_connect(sh, "source_destroy", &FlySourceTracker::onSourceDestroy, this);
+
+#ifdef ENABLE_FRONTEND_API
+	obs_frontend_add_event_callback(fly_tracker_frontend_event, this);
+#endif
+}
+
+void FlySourceTracker::stop()
+{
+	QSet<obs_source_t *> scenes;
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		if (!started_)
+			return;
+		started_ = false;
+
+		scenes.swap(connected_);
+		itemsPerScene_.clear();
+		obs_weak_source_release(weak_);
+		weak_ = nullptr;
+	}
+
+#ifdef ENABLE_FRONTEND_API
+	obs_frontend_remove_event_callback(fly_tracker_frontend_event, this);
+#endif
+
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "source_create", &FlySourceTracker::onSourceCreate, this);
+	signal_handler_disconnect(sh, "source_destroy", &FlySourceTracker::onSourceDestroy, this);
+
+	// Still-alive scenes only: destroyed ones were dropped in onSourceDestroy
+	for (obs_source_t *scene : scenes)
+		disconnectScene(scene);
+}
+
+bool FlySourceTracker::matches(obs_source_t *src) const
+{
+	if (!src)
+		return false;
+
+	const char *id = obs_source_get_id(src);
+	if (!id || strcmp(id, id_) != 0)
+		return false;
+
+	const char *name = obs_source_get_name(src);
+	return !name_ || (name && strcmp(name, name_) == 0);
+}
+
+bool FlySourceTracker::isTracked(obs_source_t *src) const
+{
+	return weak_ && obs_weak_source_references_source(weak_, src);
+}
+
+// signal_handler_(dis)connect lock the handler, which is also held while our
+// callbacks run (and wait for mtx_), so these are never called under mtx_.
+void FlySourceTracker::connectScene(obs_source_t *scene)
+{
+	signal_handler_t *sh = obs_source_get_signal_handler(scene);
+	signal_handler_connect(sh, "item_add", &FlySourceTracker::onItemAdd, this);
+	signal_handler_connect(sh, "item_remove", &FlySourceTracker::onItemRemove, this);
+}
+
+void FlySourceTracker::disconnectScene(obs_source_t *scene)
+{
+	signal_handler_t *sh = obs_source_get_signal_handler(scene);
+	signal_handler_disconnect(sh, "item_add", &FlySourceTracker::onItemAdd, this);
+	signal_handler_disconnect(sh, "item_remove", &FlySourceTracker::onItemRemove, this);
+}
+
+void FlySourceTracker::invalidate()
+{
+	std::lock_guard<std::mutex> lk(mtx_);
+	stale_ = true;
+}
+
+void FlySourceTracker::ensureIndex()
+{
+	obs_source_t *tracked = nullptr;
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		if (!started_ || !stale_)
+			return;
+		stale_ = false;
+		tracked = weak_ ? obs_weak_source_get_source(weak_) : nullptr;
+	}
+
+	// One full pass over all scenes, outside the lock (enumeration takes the
+	// scene mutexes, which item signals may hold while waiting for mtx_)
+	struct Scan {
+		FlySourceTracker *self;
+		obs_source_t *tracked;
+		QVector<obs_source_t *> scenes;
+		QHash<obs_source_t *, int> counts;
+	} scan{this, tracked, {}, {}};
+
+	obs_enum_scenes(
+		[](void *param, obs_source_t *sceneSrc) {
+			auto *s = static_cast<Scan *>(param);
+			s->scenes.push_back(sceneSrc);
+
+			obs_scene_t *scene = fly_scene_or_group(sceneSrc);
+			if (!scene)
+				return true;
+
+			struct Item {
+				Scan *scan;
+				obs_source_t *sceneSrc;
+			} item{s, sceneSrc};
+
+			obs_scene_enum_items(
+				scene,
+				[](obs_scene_t *, obs_sceneitem_t *it, void *p) {
+					auto *ctx = static_cast<Item *>(p);
+					obs_source_t *src = obs_sceneitem_get_source(it);
+					if (!ctx->scan->tracked && ctx->scan->self->matches(src))
+						ctx->scan->tracked = obs_source_get_ref(src);
+					if (src && src == ctx->scan->tracked)
+						ctx->scan->counts[ctx->sceneSrc]++;
+					return true;
+				},
+				&item);
+			return true;
+		},
+		&scan);
+
+	QVector<obs_source_t *> toConnect;
+	{
+		std::lock_guard<std::mutex> lk(mtx_);
+		if (!weak_ && scan.tracked)
+			weak_ = obs_source_get_weak_source(scan.tracked);
+		itemsPerScene_ = scan.counts;
+
+		for (obs_source_t *scene : scan.scenes) {
+			if (!connected_.contains(scene)) {
+				connected_.insert(scene);
+				toConnect.push_back(scene);
+			}
+		}
+	}
+
+	for (obs_source_t *scene : toConnect)
+		connectScene(scene);
+
+	LOGI("Indexed %d scene(s); source in %d", int(scan.scenes.size()), int(scan.counts.size()));
+	obs_source_release(scan.tracked);
+}
+
+obs_source_t *FlySourceTracker::source()
+{
+	ensureIndex();
+
+	std::lock_guard<std::mutex> lk(mtx_);
+	return weak_ ? obs_weak_source_get_source(weak_) : nullptr;
+}
+
+void FlySourceTracker::adopt(obs_source_t *src)
+{
+	if (!src)
+		return;
+
+	std::lock_guard<std::mutex> lk(mtx_);
+	if (isTracked(src))
+		return;
+
+	obs_weak_source_release(weak_);
+	weak_ = obs_source_get_weak_source(src);
+
+	// Counts referred to the previous source
+	itemsPerScene_.clear();
+	stale_ = true;
+}
+
+bool FlySourceTracker::inScene(obs_source_t *scene)
+{
+	ensureIndex();
+
+	std::lock_guard<std::mutex> lk(mtx_);
+	return itemsPerScene_.value(scene) > 0;
+}
+
+int FlySourceTracker::sceneCount()
+{
+	ensureIndex();
+
+	std::lock_guard<std::mutex> lk(mtx_);
+	return int(itemsPerScene_.size());
+}
+
+// -----------------------------------------------------------------------------
+// Signals
+// -----------------------------------------------------------------------------
+
+void FlySourceTracker::onSourceCreate(void *param, calldata_t *cd)
+{
+	auto *self = static_cast<FlySourceTracker *>(param);
+	obs_source_t *src = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!src || !fly_scene_or_group(src))
+		return;
+
+	{
+		std::lock_guard<std::mutex> lk(self->mtx_);
+		if (!self->started_ || self->connected_.contains(src))
+			return;
+		self->connected_.insert(src);
+
+		// Duplicated/loaded scenes get their items without item_add
+		self->stale_ = true;
+	}
+	self->connectScene(src);
+}
+
+void FlySourceTracker::onSourceDestroy(void *param, calldata_t *cd)
+{
+	auto *self = static_cast<FlySourceTracker *>(param);
+	obs_source_t *src = static_cast<obs_source_t *>(calldata_ptr(cd, "source"));
+	if (!src)
+		return;
+
+	std::lock_guard<std::mutex> lk(self->mtx_);
+
+	// Its signal handler goes away with it; nothing to disconnect
+	self->connected_.remove(src);
+	self->itemsPerScene_.remove(src);
+
+	if (self->isTracked(src)) {
+		obs_weak_source_release(self->weak_);
+		self->weak_ = nullptr;
+		self->itemsPerScene_.clear();
+	}
+}
+
+void FlySourceTracker::onItemAdd(void *param, calldata_t *cd)
+{
+	auto *self = static_cast<FlySourceTracker *>(param);
+	obs_scene_t *scene = static_cast<obs_scene_t *>(calldata_ptr(cd, "scene"));
+	obs_sceneitem_t *item = static_cast<obs_sceneitem_t *>(calldata_ptr(cd, "item"));
+	obs_source_t *src = item ? obs_sceneitem_get_source(item) : nullptr;
+	if (!scene || !self->matches(src))
+		return;
+
+	std::lock_guard<std::mutex> lk(self->mtx_);
+	if (!self->weak_)
+		self->weak_ = obs_source_get_weak_source(src);
+	if (self->isTracked(src))
+		self->itemsPerScene_[obs_scene_get_source(scene)]++;
+}
+
+void FlySourceTracker::onItemRemove(void *param, calldata_t *cd)
+{
+	auto *self = static_cast<FlySourceTracker *>(param);
+	obs_scene_t *scene = static_cast<obs_scene_t *>(calldata_ptr(cd, "scene"));
+	obs_sceneitem_t *item = static_cast<obs_sceneitem_t *>(calldata_ptr(cd, "item"));
+	obs_source_t *src = item ? obs_sceneitem_get_source(item) : nullptr;
+	if (!scene || !src)
+		return;
+
+	std::lock_guard<std::mutex> lk(self->mtx_);
+	if (!self->isTracked(src))
+		return;
+
+	obs_source_t *sceneSrc = obs_scene_get_source(scene);
+	auto it = self->itemsPerScene_.find(sceneSrc);
+	if (it != self->itemsPerScene_.end() && --it.value() <= 0)
+		self->itemsPerScene_.erase(it);
+}
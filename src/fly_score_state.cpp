@@ -5,9 +5,6 @@
 
 #include "fly_score_state.hpp"
 
-#include <obs-module.h>
-#include <util/platform.h>
-
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -15,14 +12,11 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 
-static QString moduleBaseDirFromConfigFile()
-{
-	char *p = obs_module_config_path("plugin.json");
-	QString filePath = p ? QString::fromUtf8(p) : QString();
-	if (p)
-		bfree(p);
-	return filePath.isEmpty() ? QDir::homePath() : QFileInfo(filePath).absolutePath();
-}
+#include <atomic>
+#include <utility>
+
+// plugin.json is rewritten constantly; only the rename is needed for readers
+static std::atomic<FlyFsyncPolicy> g_state_fsync{FlyFsyncPolicy::None};
 
 static QString overlay_dir_path(const QString &base_dir)
 {
@@ -34,26 +28,11 @@ static QString overlay_plugin_json(const QString &base_dir)
 	return QDir(overlay_dir_path(base_dir)).filePath(QStringLiteral("plugin.json"));
 }
 
-QString fly_data_dir()
-{
-	return QDir::cleanPath(moduleBaseDirFromConfigFile());
-}
-
-bool fly_ensure_webroot(QString *outBaseDir)
-{
-	const QString base = fly_data_dir();
-	const QString webroot = overlay_dir_path(base);
-	QDir().mkpath(webroot);
-	if (outBaseDir)
-		*outBaseDir = base;
-	return true;
-}
-
 static FlyTimer makeDefaultMainTimer()
 {
 	FlyTimer t;
 	t.label = QStringLiteral("First Half");
-	t.mode = QStringLiteral("countdown");
+	t.mode = FlyTimerMode::Countdown;
 	t.running = false;
 	t.initial_ms = 0;
 	t.remaining_ms = 0;
@@ -77,11 +56,21 @@ static void ensureDefaultCustomFields(FlyState &st)
 	ensureAt(1, QStringLiteral("Score"));
 }
 
+FlyTimerMode fly_timer_mode_from_string(const QString &s)
+{
+	return s == QLatin1String("countup") ? FlyTimerMode::Countup : FlyTimerMode::Countdown;
+}
+
+QString fly_timer_mode_to_string(FlyTimerMode mode)
+{
+	return mode == FlyTimerMode::Countup ? QStringLiteral("countup") : QStringLiteral("countdown");
+}
+
 static QJsonObject timerToJson(const FlyTimer &t)
 {
 	QJsonObject o;
 	o["label"] = t.label;
-	o["mode"] = t.mode;
+	o["mode"] = fly_timer_mode_to_string(t.mode);
 	o["running"] = t.running;
 	o["initial_ms"] = QString::number(t.initial_ms);
 	o["remaining_ms"] = QString::number(t.remaining_ms);
@@ -94,7 +83,7 @@ static FlyTimer timerFromJson(const QJsonObject &o)
 {
 	FlyTimer t;
 	t.label = o.value("label").toString();
-	t.mode = o.value("mode").toString("countdown");
+	t.mode = fly_timer_mode_from_string(o.value("mode").toString());
 	t.running = o.value("running").toBool(false);
 	t.initial_ms = o.value("initial_ms").toString("0").toLongLong();
 	t.remaining_ms = o.value("remaining_ms").toString("0").toLongLong();
@@ -103,6 +92,33 @@ static FlyTimer timerFromJson(const QJsonObject &o)
 	return t;
 }
 
+static QJsonObject penaltyToJson(const FlyPenalty &p)
+{
+	QJsonObject o;
+	o["id"] = static_cast<qint64>(p.id);
+	o["side"] = p.side == FlyFieldSide::Away ? QStringLiteral("away") : QStringLiteral("home");
+	o["label"] = p.label;
+	o["mode"] = QStringLiteral("countdown"); // lets the overlay reuse its timer helpers
+	o["running"] = p.running;
+	o["duration_ms"] = QString::number(p.duration_ms);
+	o["remaining_ms"] = QString::number(p.remaining_ms);
+	o["last_tick_ms"] = QString::number(p.last_tick_ms);
+	return o;
+}
+
+static FlyPenalty penaltyFromJson(const QJsonObject &o)
+{
+	FlyPenalty p;
+	p.id = static_cast<quint32>(o.value("id").toDouble(0));
+	p.side = o.value("side").toString() == QLatin1String("away") ? FlyFieldSide::Away : FlyFieldSide::Home;
+	p.label = o.value("label").toString();
+	p.running = o.value("running").toBool(false);
+	p.duration_ms = o.value("duration_ms").toString("0").toLongLong();
+	p.remaining_ms = o.value("remaining_ms").toString("0").toLongLong();
+	p.last_tick_ms = o.value("last_tick_ms").toString("0").toLongLong();
+	return p;
+}
+
 static QJsonObject toJson(const FlyState &stIn)
 {
     FlyState st = stIn;
@@ -114,6 +130,32 @@ static QJsonObject toJson(const FlyState &stIn)
 
     // ---------------------------------------------------------------------
     // Server
+    // ---------------------------------------------------------------------
+    QJsonObject srv;
+    srv["enabled"] = st.server.enabled;
+    srv["port"]    = st.server.port;
+    j["server"] = srv;
+
+    QJsonObject fc;
+    fc["enabled"]  = st.frame_clock.enabled;
+    fc["decimals"] = st.frame_clock.decimals;
+    j["frame_clock"] = fc;
+
+    QJsonObject br;
+    br["fps"]                  = st.browser.fps;
+    br["shutdown_when_hidden"] = st.browser.shutdown_when_hidden;
+    j["browser"] = br;
+
+    QJsonObject al;
+    QJsonArray thresholds;
+    for (long long t : st.alarms.thresholds_ms)
+        thresholds.append(double(t));
+    al["thresholds_ms"] = thresholds;
+    al["auto_pause"]    = st.alarms.auto_pause;
+    al["expiry_scene"]  = st.alarms.expiry_scene;
+    al["expiry_action"] = st.alarms.expiry_action;
+    j["alarms"] = al;
+
     // ---------------------------------------------------------------------
     // Teams
     // ---------------------------------------------------------------------
@@ -165,6 +207,30 @@ static QJsonObject toJson(const FlyState &stIn)
     }
     j["timers"] = timersArr;
 
+    // ---------------------------------------------------------------------
+    // Penalties (active only)
+    // ---------------------------------------------------------------------
+    QJsonObject penCfg;
+    penCfg["duration_ms"] = QString::number(st.penalty.duration_ms);
+    penCfg["field_index"] = st.penalty.field_index;
+    j["penalty"] = penCfg;
+
+    QJsonArray penArr;
+    for (const auto &p : st.penalties)
+        penArr.append(penaltyToJson(p));
+    j["penalties"] = penArr;
+
+    // ---------------------------------------------------------------------
+    // Latency probe (only while it runs)
+    // ---------------------------------------------------------------------
+    if (st.probe.seq) {
+        QJsonObject pr;
+        pr["seq"]     = double(st.probe.seq);
+        pr["sent_ms"] = double(st.probe.sent_ms);
+        pr["ack"]     = st.probe.ack;
+        j["probe"] = pr;
+    }
+
     return j;
 }
 
@@ -172,6 +238,34 @@ static bool fromJson(const QJsonObject &j, FlyState &st)
 {
     // ---------------------------------------------------------------------
     // Server
+    // ---------------------------------------------------------------------
+    const QJsonObject srv = j.value("server").toObject();
+    st.server.enabled = srv.value("enabled").toBool(true);
+    st.server.port    = srv.value("port").toInt(8089);
+    if (st.server.port <= 0 || st.server.port > 65535)
+        st.server.port = 8089;
+
+    const QJsonObject fc = j.value("frame_clock").toObject();
+    st.frame_clock.enabled  = fc.value("enabled").toBool(false);
+    st.frame_clock.decimals = qBound(0, fc.value("decimals").toInt(1), 2);
+
+    const QJsonObject br = j.value("browser").toObject();
+    st.browser.fps                  = qBound(0, br.value("fps").toInt(30), 60);
+    st.browser.shutdown_when_hidden = br.value("shutdown_when_hidden").toBool(true);
+
+    const QJsonObject al = j.value("alarms").toObject();
+    st.alarms = FlyAlarmConfig();
+    if (al.value("thresholds_ms").isArray()) {
+        st.alarms.thresholds_ms.clear();
+        for (const QJsonValue v : al.value("thresholds_ms").toArray()) {
+            if (v.isDouble() && v.toDouble() >= 0)
+                st.alarms.thresholds_ms.push_back(static_cast<long long>(v.toDouble()));
+        }
+    }
+    st.alarms.auto_pause    = al.value("auto_pause").toBool(true);
+    st.alarms.expiry_scene  = al.value("expiry_scene").toString();
+    st.alarms.expiry_action = al.value("expiry_action").toString();
+
     // ---------------------------------------------------------------------
     // Helper: robust color reader
     // ---------------------------------------------------------------------
@@ -268,13 +362,188 @@ static bool fromJson(const QJsonObject &j, FlyState &st)
     if (st.timers.isEmpty())
         st.timers.push_back(makeDefaultMainTimer());
 
-    FlyTimer &main = st.timers[0];
-    if (main.mode.isEmpty())
-        main.mode = "countdown";
+    // ---------------------------------------------------------------------
+    // Penalties
+    // ---------------------------------------------------------------------
+    const QJsonObject penCfg = j.value("penalty").toObject();
+    st.penalty.duration_ms = penCfg.value("duration_ms").toString("120000").toLongLong();
+    if (st.penalty.duration_ms <= 0)
+        st.penalty.duration_ms = 120000;
+    st.penalty.field_index = penCfg.value("field_index").toInt(-1);
+
+    st.penalties.clear();
+    const QJsonArray penArr = j.value("penalties").toArray();
+    st.penalties.reserve(penArr.size());
+    for (const QJsonValue v : penArr) {
+        if (v.isObject())
+            st.penalties.push_back(penaltyFromJson(v.toObject()));
+    }
 
     return true;
 }
 
+// -----------------------------------------------------------------------------
+// Typed mutations
+// -----------------------------------------------------------------------------
+
+bool fly_state_set_field_value(FlyState &st, int index, FlyFieldSide side, int value)
+{
+	if (index < 0 || index >= st.custom_fields.size())
+		return false;
+
+	const int v = qBound(0, value, kFlyFieldValueMax);
+	FlyCustomField &cf = st.custom_fields[index];
+	int &slot = (side == FlyFieldSide::Home) ? cf.home : cf.away;
+	if (slot == v)
+		return false;
+
+	slot = v;
+	return true;
+}
+
+bool fly_state_set_field_visible(FlyState &st, int index, bool visible)
+{
+	if (index < 0 || index >= st.custom_fields.size())
+		return false;
+
+	FlyCustomField &cf = st.custom_fields[index];
+	if (cf.visible == visible)
+		return false;
+
+	cf.visible = visible;
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+// Diff engine
+// -----------------------------------------------------------------------------
+
+static void diffObject(const QString &prefix, const QJsonObject &a, const QJsonObject &b, FlyStatePatch &out);
+
+static void diffValue(const QString &path, const QJsonValue &a, const QJsonValue &b, FlyStatePatch &out)
+{
+	if (a == b)
+		return;
+
+	if (a.isObject() && b.isObject()) {
+		diffObject(path, a.toObject(), b.toObject(), out);
+		return;
+	}
+
+	if (a.isArray() && b.isArray()) {
+		const QJsonArray aa = a.toArray();
+		const QJsonArray bb = b.toArray();
+		if (aa.size() == bb.size()) {
+			for (int i = 0; i < aa.size(); ++i)
+				diffValue(path + QStringLiteral("[%1]").arg(i), aa.at(i), bb.at(i), out);
+			return;
+		}
+	}
+
+	out.push_back({FlyStatePatchOp::Set, path, b});
+}
+
+static void diffObject(const QString &prefix, const QJsonObject &a, const QJsonObject &b, FlyStatePatch &out)
+{
+	auto join = [&](const QString &key) {
+		return prefix.isEmpty() ? key : prefix + QLatin1Char('.') + key;
+	};
+
+	for (auto it = b.begin(); it != b.end(); ++it) {
+		const auto ai = a.constFind(it.key());
+		if (ai == a.constEnd())
+			out.push_back({FlyStatePatchOp::Set, join(it.key()), it.value()});
+		else
+			diffValue(join(it.key()), ai.value(), it.value(), out);
+	}
+
+	for (auto it = a.begin(); it != a.end(); ++it) {
+		if (!b.contains(it.key()))
+			out.push_back({FlyStatePatchOp::Remove, join(it.key()), QJsonValue()});
+	}
+}
+
+FlyStatePatch fly_state_diff(const QJsonObject &from, const QJsonObject &to)
+{
+	FlyStatePatch ops;
+	diffObject(QString(), from, to, ops);
+	return ops;
+}
+
+QJsonArray fly_state_patch_to_json(const FlyStatePatch &patch)
+{
+	QJsonArray arr;
+	for (const auto &op : patch) {
+		QJsonObject o;
+		if (op.kind == FlyStatePatchOp::Remove) {
+			o["op"] = QStringLiteral("remove");
+			o["path"] = op.path;
+		} else {
+			o["op"] = QStringLiteral("set");
+			o["path"] = op.path;
+			o["value"] = op.value;
+		}
+		arr.append(o);
+	}
+	return arr;
+}
+
+FlyStateHistory::FlyStateHistory(int capacity) : ring_(qMax(1, capacity)) {}
+
+quint64 FlyStateHistory::commit(const FlyState &st)
+{
+	QJsonObject next = toJson(st);
+
+	if (revision_ == 0) {
+		current_ = std::move(next);
+		revision_ = 1;
+		return revision_;
+	}
+
+	FlyStatePatch ops = fly_state_diff(current_, next);
+	if (ops.isEmpty())
+		return revision_;
+
+	++revision_;
+	Entry &e = ring_[int(revision_ % quint64(ring_.size()))];
+	e.revision = revision_;
+	e.ops = std::move(ops);
+	count_ = qMin(count_ + 1, int(ring_.size()));
+	current_ = std::move(next);
+	return revision_;
+}
+
+bool FlyStateHistory::patchesSince(quint64 since, FlyStatePatch &out) const
+{
+	out.clear();
+	if (since == 0 || since > revision_)
+		return false;
+	if (revision_ - since > quint64(count_))
+		return false;
+
+	for (quint64 r = since + 1; r <= revision_; ++r) {
+		const Entry &e = ring_[int(r % quint64(ring_.size()))];
+		if (e.revision != r)
+			return false;
+		out += e.ops;
+	}
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+// Public JSON wrappers
+// -----------------------------------------------------------------------------
+
+QJsonObject fly_state_to_json(const FlyState &st)
+{
+	return toJson(st);
+}
+
+bool fly_state_from_json(const QJsonObject &j, FlyState &out)
+{
+	return fromJson(j, out);
+}
+
 bool fly_state_read_json(const std::string &base_dir_s, std::string &out_json)
 {
 	const QString base_dir = QString::fromStdString(base_dir_s);
@@ -291,22 +560,12 @@ bool fly_state_write_json(const std::string &base_dir_s, const std::string &json
 {
 	const QString base_dir = QString::fromStdString(base_dir_s);
 	const QString path = overlay_plugin_json(base_dir);
-	QDir().mkpath(QFileInfo(path).absolutePath());
-	QFile f(path);
-	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
-		return false;
-	f.write(QByteArray::fromStdString(json));
-	return true;
+	return fly_atomic_write_file(path, QByteArray::fromStdString(json), g_state_fsync.load());
 }
 
-static bool write_one_json(const QString &path, const QJsonDocument &doc)
+void fly_state_set_fsync_policy(FlyFsyncPolicy policy)
 {
-	QDir().mkpath(QFileInfo(path).absolutePath());
-	QFile f(path);
-	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
-		return false;
-	f.write(doc.toJson(QJsonDocument::Compact));
-	return true;
+	g_state_fsync.store(policy);
 }
 
 bool fly_state_load(const QString &base_dir, FlyState &out)
@@ -323,11 +582,19 @@ bool fly_state_load(const QString &base_dir, FlyState &out)
 	return fromJson(doc.object(), out);
 }
 
+QByteArray fly_state_serialize(const FlyState &st)
+{
+	return QJsonDocument(toJson(st)).toJson(QJsonDocument::Compact);
+}
+
+bool fly_state_save_serialized(const QString &base_dir, const QByteArray &json)
+{
+	return fly_atomic_write_file(overlay_plugin_json(base_dir), json, g_state_fsync.load());
+}
+
 bool fly_state_save(const QString &base_dir, const FlyState &st)
 {
-	const QJsonDocument doc(toJson(st));
-	const QString path = overlay_plugin_json(base_dir);
-	return write_one_json(path, doc);
+	return fly_state_save_serialized(base_dir, fly_state_serialize(st));
 }
 
 FlyState fly_state_make_defaults()
@@ -5,6 +5,7 @@
 #include "fly_score_log.hpp"
 
 #include "fly_score_logo_helpers.hpp"
+#include "fly_score_profiler.hpp"
 #include "fly_score_qt_helpers.hpp"
 #include "fly_score_state.hpp"
 
@@ -301,7 +302,11 @@ void FlyTeamsDialog::onBrowseHomeLogo()
 	if (p.isEmpty())
 		return;
 
-	const QString rel = fly_copy_logo_to_overlay(dataDir_, p, QStringLiteral("home"));
+	QString rel;
+	{
+		FLY_PROFILE_SCOPE("fly_copy_logo_to_overlay");
+		rel = fly_copy_logo_to_overlay(dataDir_, p, QStringLiteral("home"));
+	}
 	if (rel.isEmpty()) {
 		QMessageBox::warning(this, QStringLiteral("Fly Score Teams"),
 				     QStringLiteral("Failed to copy logo to overlay folder."));
@@ -324,7 +329,11 @@ void FlyTeamsDialog::onBrowseAwayLogo()
 	if (p.isEmpty())
 		return;
 
-	const QString rel = fly_copy_logo_to_overlay(dataDir_, p, QStringLiteral("guest"));
+	QString rel;
+	{
+		FLY_PROFILE_SCOPE("fly_copy_logo_to_overlay");
+		rel = fly_copy_logo_to_overlay(dataDir_, p, QStringLiteral("guest"));
+	}
 	if (rel.isEmpty()) {
 		QMessageBox::warning(this, QStringLiteral("Fly Score Teams"),
 				     QStringLiteral("Failed to copy logo to overlay folder."));
@@ -0,0 +1,221 @@
+#include "fly_score_timer_engine.hpp"
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <chrono>
+
+int64_t FlyTimerEngine::steadyNowMs()
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static int64_t default_wall_ms()
+{
+	return QDateTime::currentMSecsSinceEpoch();
+}
+
+FlyTimerEngine::FlyTimerEngine(ClockMs steadyMs, ClockMs wallMs)
+	: steadyMs_(steadyMs ? std::move(steadyMs) : ClockMs(&FlyTimerEngine::steadyNowMs)),
+	  wallMs_(wallMs ? std::move(wallMs) : ClockMs(default_wall_ms))
+{
+}
+
+void FlyTimerEngine::load(const QVector<FlyTimer> &timers)
+{
+	const int64_t steadyNow = steadyMs_();
+	const int64_t wallNow = wallMs_();
+
+	timers_.clear();
+	timers_.reserve(timers.size());
+
+	for (const FlyTimer &t : timers) {
+		Slot s;
+		s.timer = t;
+		s.timer.initial_ms = std::max<long long>(0, t.initial_ms);
+		s.timer.remaining_ms = std::max<long long>(0, t.remaining_ms);
+		s.steadyAnchorMs = steadyNow;
+
+		// Persisted while running: the wall anchor is all we have to bridge the gap
+		if (t.running && t.last_tick_ms > 0) {
+			const int64_t gap = std::max<int64_t>(0, wallNow - t.last_tick_ms);
+			s.steadyAnchorMs = steadyNow - gap;
+			rebase(s, steadyNow);
+		}
+
+		timers_.push_back(std::move(s));
+	}
+}
+
+QVector<FlyTimer> FlyTimerEngine::snapshot() const
+{
+	const int64_t steadyNow = steadyMs_();
+	const int64_t wallNow = wallMs_();
+
+	QVector<FlyTimer> out;
+	out.reserve(timers_.size());
+
+	for (const Slot &s : timers_) {
+		FlyTimer t = s.timer;
+		if (t.running) {
+			// Express the steady anchor as a wall time for the overlay
+			t.remaining_ms = liveValue(s, steadyNow);
+			t.last_tick_ms = wallNow;
+		} else {
+			t.last_tick_ms = 0;
+		}
+		out.push_back(std::move(t));
+	}
+	return out;
+}
+
+QVector<FlyTimerEngine::Anchor> FlyTimerEngine::anchors() const
+{
+	QVector<Anchor> out;
+	out.reserve(timers_.size());
+	for (const Slot &s : timers_)
+		out.push_back({s.timer.running, s.timer.mode, s.timer.remaining_ms, s.steadyAnchorMs});
+	return out;
+}
+
+int64_t FlyTimerEngine::valueAt(const Anchor &a, int64_t steadyMs)
+{
+	if (!a.running)
+		return a.valueMs;
+
+	const int64_t elapsed = std::max<int64_t>(0, steadyMs - a.steadyAnchorMs);
+	if (a.mode == FlyTimerMode::Countup)
+		return a.valueMs + elapsed;
+
+	return std::max<int64_t>(0, a.valueMs - elapsed);
+}
+
+bool FlyTimerEngine::anyRunning() const
+{
+	const int64_t steadyNow = steadyMs_();
+	return std::any_of(timers_.cbegin(), timers_.cend(), [this, steadyNow](const Slot &s) {
+		if (!s.timer.running)
+			return false;
+		// A countdown parked at 0 keeps its running flag (auto-pause may be off)
+		// but its value no longer moves
+		return s.timer.mode == FlyTimerMode::Countup || liveValue(s, steadyNow) > 0;
+	});
+}
+
+bool FlyTimerEngine::isRunning(int index) const
+{
+	return valid(index) && timers_[index].timer.running;
+}
+
+FlyTimerMode FlyTimerEngine::mode(int index) const
+{
+	return valid(index) ? timers_[index].timer.mode : FlyTimerMode::Countdown;
+}
+
+int64_t FlyTimerEngine::valueMs(int index) const
+{
+	if (!valid(index))
+		return 0;
+	return liveValue(timers_[index], steadyMs_());
+}
+
+int64_t FlyTimerEngine::liveValue(const Slot &s, int64_t steadyNow) const
+{
+	return valueAt({s.timer.running, s.timer.mode, s.timer.remaining_ms, s.steadyAnchorMs}, steadyNow);
+}
+
+void FlyTimerEngine::rebase(Slot &s, int64_t steadyNow)
+{
+	s.timer.remaining_ms = liveValue(s, steadyNow);
+	s.steadyAnchorMs = steadyNow;
+}
+
+bool FlyTimerEngine::start(int index)
+{
+	if (!valid(index) || timers_[index].timer.running)
+		return false;
+
+	Slot &s = timers_[index];
+	s.timer.running = true;
+	s.steadyAnchorMs = steadyMs_();
+	return true;
+}
+
+bool FlyTimerEngine::pause(int index)
+{
+	if (!valid(index) || !timers_[index].timer.running)
+		return false;
+
+	Slot &s = timers_[index];
+	rebase(s, steadyMs_());
+	s.timer.running = false;
+	return true;
+}
+
+bool FlyTimerEngine::toggle(int index)
+{
+	return isRunning(index) ? pause(index) : start(index);
+}
+
+bool FlyTimerEngine::reset(int index)
+{
+	if (!valid(index))
+		return false;
+
+	FlyTimer &t = timers_[index].timer;
+	if (!t.running && t.remaining_ms == t.initial_ms)
+		return false;
+
+	t.running = false;
+	t.remaining_ms = t.initial_ms;
+	return true;
+}
+
+bool FlyTimerEngine::resetAll()
+{
+	bool changed = false;
+	for (int i = 0; i < timers_.size(); ++i)
+		changed |= reset(i);
+	return changed;
+}
+
+bool FlyTimerEngine::setPreset(int index, int64_t ms)
+{
+	if (!valid(index) || timers_[index].timer.running)
+		return false;
+
+	FlyTimer &t = timers_[index].timer;
+	ms = std::max<int64_t>(0, ms);
+	if (t.initial_ms == ms && t.remaining_ms == ms)
+		return false;
+
+	t.initial_ms = ms;
+	t.remaining_ms = ms;
+	return true;
+}
+
+bool FlyTimerEngine::adjust(int index, int64_t deltaMs)
+{
+	if (!valid(index) || deltaMs == 0)
+		return false;
+
+	Slot &s = timers_[index];
+	rebase(s, steadyMs_());
+
+	const int64_t v = std::max<int64_t>(0, s.timer.remaining_ms + deltaMs);
+	if (v == s.timer.remaining_ms)
+		return false;
+
+	s.timer.remaining_ms = v;
+	return true;
+}
+
+bool FlyTimerEngine::setVisible(int index, bool visible)
+{
+	if (!valid(index) || timers_[index].timer.visible == visible)
+		return false;
+
+	timers_[index].timer.visible = visible;
+	return true;
+}
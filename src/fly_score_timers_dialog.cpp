@@ -109,10 +109,7 @@ FlyTimersDialog::Row FlyTimersDialog::addRow(const FlyTimer &tm, bool canRemove)
 
 	auto *modeCombo = new QComboBox(row);
 	modeCombo->addItems({QStringLiteral("countdown"), QStringLiteral("countup")});
-	if (tm.mode.isEmpty())
-		modeCombo->setCurrentText(QStringLiteral("countdown"));
-	else
-		modeCombo->setCurrentText(tm.mode);
+	modeCombo->setCurrentText(fly_timer_mode_to_string(tm.mode));
 	modeCombo->setMinimumWidth(110);
 	modeCombo->setMaximumWidth(140);
 
@@ -182,7 +179,7 @@ void FlyTimersDialog::loadFromState()
 	if (st_.timers.isEmpty()) {
 		FlyTimer main;
 		main.label = QStringLiteral("First Half");
-		main.mode = QStringLiteral("countdown");
+		main.mode = FlyTimerMode::Countdown;
 		main.running = false;
 		main.initial_ms = 0;
 		main.remaining_ms = 0;
@@ -213,8 +210,7 @@ void FlyTimersDialog::saveToState()
 		FlyTimer tm;
 		tm.label = r.labelEdit ? r.labelEdit->text() : QString();
 
-		QString mode = r.modeCombo ? r.modeCombo->currentText() : QStringLiteral("countdown");
-		tm.mode = mode;
+		tm.mode = r.modeCombo ? fly_timer_mode_from_string(r.modeCombo->currentText()) : FlyTimerMode::Countdown;
 
 		qint64 ms = 0;
 		if (r.timeEdit) {
@@ -240,7 +236,7 @@ void FlyTimersDialog::saveToState()
 	if (st_.timers.isEmpty()) {
 		FlyTimer main;
 		main.label = QStringLiteral("First Half");
-		main.mode = QStringLiteral("countdown");
+		main.mode = FlyTimerMode::Countdown;
 		main.running = false;
 		main.initial_ms = 0;
 		main.remaining_ms = 0;
@@ -256,7 +252,7 @@ void FlyTimersDialog::onAddTimer()
 {
 	FlyTimer tm;
 	tm.label = QString();
-	tm.mode = QStringLiteral("countdown");
+	tm.mode = FlyTimerMode::Countdown;
 	tm.running = false;
 	tm.initial_ms = 0;
 	tm.remaining_ms = 0;
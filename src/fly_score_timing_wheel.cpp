@@ -0,0 +1,189 @@
+#include "fly_score_timing_wheel.hpp"
+
+#include <algorithm>
+
+FlyTimingWheel::FlyTimingWheel(int64_t tickMs, int64_t startMs) : tickMs_(std::max<int64_t>(1, tickMs)), currentTick_(0)
+{
+	reset(startMs);
+}
+
+void FlyTimingWheel::reset(int64_t startMs)
+{
+	nodes_.clear();
+	free_.clear();
+	fired_.clear();
+	live_ = 0;
+
+	for (auto &level : heads_)
+		std::fill(std::begin(level), std::end(level), -1);
+
+	// Round down: the start tick counts as processed
+	currentTick_ = startMs >= 0 ? startMs / tickMs_ : -((-startMs + tickMs_ - 1) / tickMs_);
+}
+
+int64_t FlyTimingWheel::tickFor(int64_t ms) const
+{
+	// Round up so a deadline never fires before its time
+	if (ms >= 0)
+		return (ms + tickMs_ - 1) / tickMs_;
+	return -((-ms) / tickMs_);
+}
+
+FlyTimingWheel::Handle FlyTimingWheel::schedule(int64_t dueMs, uint64_t payload)
+{
+	int32_t idx;
+	if (!free_.empty()) {
+		idx = free_.back();
+		free_.pop_back();
+	} else {
+		idx = static_cast<int32_t>(nodes_.size());
+		nodes_.emplace_back();
+	}
+
+	Node &n = nodes_[idx];
+	n.dueMs = dueMs;
+	// Already due: fire on the next processed tick
+	n.dueTick = std::max(tickFor(dueMs), currentTick_ + 1);
+	n.payload = payload;
+
+	place(idx);
+	++live_;
+
+	return (uint64_t(n.gen) << 32) | uint64_t(idx + 1);
+}
+
+bool FlyTimingWheel::cancel(Handle h)
+{
+	const int64_t slot = int64_t(h & 0xffffffffu) - 1;
+	const uint32_t gen = uint32_t(h >> 32);
+	if (slot < 0 || slot >= int64_t(nodes_.size()))
+		return false;
+
+	const auto idx = static_cast<int32_t>(slot);
+	if (nodes_[idx].gen != gen || nodes_[idx].level < 0)
+		return false;
+
+	unlink(idx);
+	release(idx);
+	return true;
+}
+
+void FlyTimingWheel::place(int32_t idx)
+{
+	Node &n = nodes_[idx];
+	const int64_t delta = std::max<int64_t>(0, n.dueTick - currentTick_);
+
+	int level = 0;
+	while (level < kLevels - 1 && delta >= (int64_t(1) << (kBits * (level + 1))))
+		++level;
+
+	// Beyond the wheel's span: park in the last level's furthest slot
+	int64_t tick = n.dueTick;
+	const int64_t span = int64_t(1) << (kBits * kLevels);
+	if (delta >= span)
+		tick = currentTick_ + span - 1;
+
+	link(idx, level, int((uint64_t(tick) >> (kBits * level)) & kSlotMask));
+}
+
+void FlyTimingWheel::link(int32_t idx, int level, int slot)
+{
+	Node &n = nodes_[idx];
+	n.level = int16_t(level);
+	n.slot = int16_t(slot);
+	n.prev = -1;
+	n.next = heads_[level][slot];
+	if (n.next >= 0)
+		nodes_[n.next].prev = idx;
+	heads_[level][slot] = idx;
+}
+
+void FlyTimingWheel::unlink(int32_t idx)
+{
+	Node &n = nodes_[idx];
+	if (n.prev >= 0)
+		nodes_[n.prev].next = n.next;
+	else
+		heads_[n.level][n.slot] = n.next;
+	if (n.next >= 0)
+		nodes_[n.next].prev = n.prev;
+
+	n.prev = n.next = -1;
+	n.level = n.slot = -1;
+}
+
+void FlyTimingWheel::release(int32_t idx)
+{
+	Node &n = nodes_[idx];
+	++n.gen;
+	n.level = n.slot = -1;
+	free_.push_back(idx);
+	--live_;
+}
+
+void FlyTimingWheel::cascade(int level)
+{
+	const int slot = int((uint64_t(currentTick_) >> (kBits * level)) & kSlotMask);
+
+	int32_t idx = heads_[level][slot];
+	heads_[level][slot] = -1;
+
+	while (idx >= 0) {
+		const int32_t next = nodes_[idx].next;
+		place(idx); // lands in a lower level (or the current level-0 slot)
+		idx = next;
+	}
+}
+
+void FlyTimingWheel::advance(int64_t nowMs, const FireFn &fire)
+{
+	// Round down: only whole elapsed ticks are processed
+	const int64_t target = nowMs >= 0 ? nowMs / tickMs_ : -((-nowMs + tickMs_ - 1) / tickMs_);
+
+	while (currentTick_ < target) {
+		if (live_ == 0) {
+			currentTick_ = target;
+			return;
+		}
+
+		++currentTick_;
+
+		// Entering a new block at level L pulls that block's timers down.
+		// Ascending order is safe: whatever a higher level drops into the
+		// block that just started is already within level-0 range.
+		for (int level = 1; level < kLevels; ++level) {
+			if ((uint64_t(currentTick_) & ((uint64_t(1) << (kBits * level)) - 1)) != 0)
+				break;
+			cascade(level);
+		}
+
+		const int slot = int(uint64_t(currentTick_) & kSlotMask);
+		int32_t idx = heads_[0][slot];
+		heads_[0][slot] = -1;
+
+		fired_.clear();
+		while (idx >= 0) {
+			Node &n = nodes_[idx];
+			const int32_t next = n.next;
+
+			if (n.dueTick <= currentTick_) {
+				fired_.push_back({n.payload, n.dueMs});
+				n.prev = n.next = -1;
+				release(idx);
+			} else {
+				// Parked beyond the span; keep cascading it
+				place(idx);
+			}
+			idx = next;
+		}
+
+		std::sort(fired_.begin(), fired_.end(), [](const Fired &a, const Fired &b) { return a.dueMs < b.dueMs; });
+
+		if (fire) {
+			// Callbacks may re-enter schedule(); iterate over a stable copy
+			const std::vector<Fired> batch = fired_;
+			for (const Fired &f : batch)
+				fire(f.payload, f.dueMs);
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+
+/**
+ * Typed scoreboard actions.
+ *
+ * Action IDs ("swap_sides", "field_3_home_inc", "timer_1_toggle", ...) are the
+ * persisted form used by hotkeys.json. They are parsed once into a FlyAction
+ * (kind + index); everything that triggers actions (shortcuts, a remote API,
+ * macros) dispatches on the kind through a flat table instead of re-reading
+ * the string.
+ */
+enum class FlyActionKind : uint8_t {
+	None = 0,
+	SwapSides,
+	ToggleScoreboard,
+	FieldToggle,
+	FieldHomeInc,
+	FieldHomeDec,
+	FieldAwayInc,
+	FieldAwayDec,
+	TimerToggle,
+	PenaltyHomeAdd,
+	PenaltyHomeRemove,
+	PenaltyAwayAdd,
+	PenaltyAwayRemove,
+
+	Count
+};
+
+struct FlyAction {
+	FlyActionKind kind = FlyActionKind::None;
+	int index = -1; // custom field / timer index; -1 for scoreboard actions
+
+	bool isValid() const { return kind != FlyActionKind::None; }
+
+	friend bool operator==(const FlyAction &a, const FlyAction &b)
+	{
+		return a.kind == b.kind && a.index == b.index;
+	}
+	friend bool operator!=(const FlyAction &a, const FlyAction &b) { return !(a == b); }
+};
+
+enum class FlyActionGroup { Scoreboard, Fields, Timers };
+
+// "field_3_home_inc" -> {FieldHomeInc, 3}. Unknown IDs yield kind None.
+FlyAction fly_action_parse(const QString &actionId);
+
+// Inverse of fly_action_parse(); empty for kind None.
+QString fly_action_id(const FlyAction &action);
+
+FlyActionGroup fly_action_group(FlyActionKind kind);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include <cstdint>
+
+#include "fly_score_timer_engine.hpp"
+
+/**
+ * Deadline-driven threshold alarms for countdown timers.
+ *
+ * rearm() turns the engine's anchors into absolute steady-clock deadlines
+ * ("timer 0 reaches 10 s at t"), sorted, and arms one precise single-shot
+ * QTimer for the earliest of them. Nothing polls: between deadlines the
+ * scheduler is idle, and it is re-armed whenever the timers change (start,
+ * pause, reset, preset, ...). Thresholds already passed are not reported.
+ *
+ * alarm() is emitted on the owner's thread; lateMs is how far after the exact
+ * deadline it was delivered.
+ */
+class FlyAlarmScheduler : public QObject {
+	Q_OBJECT
+public:
+	explicit FlyAlarmScheduler(QObject *parent = nullptr);
+
+	// In ms; 0 means expiry. Duplicates and negatives are dropped.
+	void setThresholds(const QVector<long long> &thresholdsMs);
+
+	void rearm(const QVector<FlyTimerEngine::Anchor> &anchors);
+	void clear();
+
+	int pendingCount() const { return int(pending_.size()); }
+
+signals:
+	void alarm(int timerIndex, qint64 thresholdMs, qint64 lateMs);
+
+private:
+	struct Pending {
+		int timer = -1;
+		long long thresholdMs = 0;
+		int64_t dueSteadyMs = 0;
+	};
+
+	void armNext();
+	void onTimeout();
+
+	QVector<long long> thresholds_;
+	QVector<Pending> pending_; // sorted by dueSteadyMs
+	QTimer timer_;
+};
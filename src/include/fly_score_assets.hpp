@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+
+struct FlyAsset {
+	QByteArray data;
+	QByteArray etag; // strong validator, already quoted
+	bool embedded = false;
+};
+
+/**
+ * Overlay assets for the localhost server.
+ *
+ * A file in the resources folder always wins; index.html, style.css and
+ * script.js fall back to the copies compiled into the plugin
+ * (EMBED_DEFAULT_ASSETS), so a fresh resources folder needs nothing on disk.
+ * Files are cached in memory and re-read only when size/mtime change.
+ *
+ * Not thread-safe; owned by the server thread.
+ */
+class FlyAssetStore {
+public:
+	void setRoot(const QString &docRoot);
+
+	// relPath is the URL path, e.g. "/index.html"
+	bool lookup(const QString &relPath, FlyAsset &out);
+
+private:
+	struct CachedFile {
+		QDateTime mtime;
+		qint64 size = -1;
+		FlyAsset asset;
+	};
+
+	QString root_;
+	QHash<QString, CachedFile> files_;
+};
+
+// Compiled-in default for `name` ("index.html", ...); false if not embedded
+bool fly_embedded_asset(const QString &name, FlyAsset &out);
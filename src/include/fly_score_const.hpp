@@ -4,5 +4,12 @@ inline constexpr const char *kBrowserSourceId = "browser_source";
 inline constexpr const char *kBrowserSourceName = "Fly Scoreboard";
 inline constexpr int kBrowserWidth = 1200;
 inline constexpr int kBrowserHeight = 200;
+inline constexpr const char *kNativeSourceId = "fly_scoreboard_native";
+inline constexpr const char *kNativeSourceName = "Fly Scoreboard (native)";
 inline constexpr const char *kFlyDockId = "FlyScoreDock";
 inline constexpr const char *kFlyDockTitle = "Fly Score";
+inline constexpr int kPersistCoalesceMs = 100;
+inline constexpr int kFieldsTableThreshold = 24;
+inline constexpr int kDockTimerTickMs = 250;
+inline constexpr int kDiagnosticsRefreshMs = 1000;
+inline constexpr int kDiagnosticsLogMs = 60 * 1000;
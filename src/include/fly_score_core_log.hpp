@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * Logging for fly_score_core, which must build without libobs.
+ *
+ * Core sources (compiled with FLY_SCORE_CORE) route LOGI/LOGW/... here instead
+ * of blog(). Messages go to stderr until a handler is installed; the plugin
+ * installs one forwarding to blog() on load, so the OBS log looks the same.
+ */
+
+// Same values as libobs (util/base.h), so a handler can pass them straight on
+#ifndef LOG_ERROR
+#define LOG_ERROR 100
+#define LOG_WARNING 200
+#define LOG_INFO 300
+#define LOG_DEBUG 400
+#endif
+
+using FlyLogHandler = void (*)(int level, const char *msg);
+
+// nullptr restores the stderr default
+void fly_core_set_log_handler(FlyLogHandler handler);
+
+void fly_core_log(int level, const char *fmt, ...)
+#if defined(__GNUC__) || defined(__clang__)
+	__attribute__((format(printf, 2, 3)))
+#endif
+	;
@@ -2,10 +2,20 @@
 
 #include <QWidget>
 #include <QString>
+#include <QHash>
 #include <QList>
+#include <QStringList>
 #include <QKeySequence>
 
 #include "fly_score_state.hpp"
+#include "fly_score_persist.hpp"
+#include "fly_score_server.hpp"
+#include "fly_score_timer_engine.hpp"
+#include "fly_score_penalties.hpp"
+#include "fly_score_frame_clock.hpp"
+#include "fly_score_alarms.hpp"
+#include "fly_score_native_source.hpp"
+#include "fly_score_const.hpp"
 
 class QPushButton;
 class QSpinBox;
@@ -14,6 +24,9 @@ class QCheckBox;
 class QVBoxLayout;
 class QLabel;
 class QShortcut;
+class QTableView;
+class QTimer;
+class FlyCustomFieldsModel;
 
 // UI bundle for a single custom field row in the dock
 struct FlyCustomFieldUi {
@@ -38,15 +51,24 @@ struct FlyTimerUi {
 	QCheckBox *visibleCheck = nullptr;
 };
 
-// Forward-declared; defined in fly_score_hotkeys_dialog.hpp
+// Forward-declared; defined in fly_score_hotkeys_dialog.hpp / fly_score_actions.hpp
 struct FlyHotkeyBinding;
+struct FlyAction;
 
 class FlyScoreDock : public QWidget {
 	Q_OBJECT
 public:
 	explicit FlyScoreDock(QWidget *parent = nullptr);
+	~FlyScoreDock() override;
 	bool init();
 
+	// Single entry point for parsed actions (shortcuts, macros, remote triggers)
+	void triggerAction(const FlyAction &action);
+
+	// Penalties: add one with the configured duration / drop the side's next to expire
+	void addPenalty(FlyFieldSide side);
+	void removePenalty(FlyFieldSide side);
+
 public slots:
 	// Match stats from hotkeys
 	void bumpCustomFieldHome(int index, int delta);
@@ -66,6 +88,11 @@ public slots:
 	// Ensure plugin.json exists in current resources path
 	void ensureResourcesDefaults();
 
+signals:
+	// A countdown crossed one of st_.alarms.thresholds_ms (0 = expired); after
+	// the built-in hooks (auto-pause, scene, action) have run
+	void timerAlarm(int timerIndex, qint64 thresholdMs);
+
 private slots:
 	void onClearTeamsAndReset();
 
@@ -81,28 +108,98 @@ private:
 	void saveState();
 	void refreshUiFromState(bool onlyTimeIfRunning = false);
 
-	// Custom fields quick controls
-	void clearAllCustomFieldRows();
+	// Custom fields quick controls (rows are reconciled, not rebuilt)
+	void trimCustomFieldRows(int count);
 	void loadCustomFieldControlsFromState();
-	void syncCustomFieldControlsToState();
+	FlyCustomFieldUi createCustomFieldRow(int index);
+	void updateCustomFieldRow(FlyCustomFieldUi &ui, const FlyCustomField &cf);
+	void ensureCustomFieldsTable();
 
-	// Timers quick controls
-	void clearAllTimerRows();
+	// Typed single-field mutations: change one element, refresh its row, save
+	void setCustomFieldValue(int index, FlyFieldSide side, int value);
+	void setCustomFieldVisible(int index, bool visible);
+	void refreshCustomFieldRow(int index);
+
+	// Timers quick controls (rows are reconciled, not rebuilt)
+	void trimTimerRows(int count);
 	void loadTimerControlsFromState();
+	FlyTimerUi createTimerRow(int index);
+	void updateTimerRow(FlyTimerUi &ui, const FlyTimer &tm);
+
+	// Publish the timer engine's snapshot into st_ and save
+	void commitTimers();
+
+	// Low-frequency display tick; runs only while a timer is running
+	void updateTimerTickDriver();
+	void onTimerTick();
+
+	// Start/stop OBS-frame-aligned timer publishing per st_.frame_clock
+	void applyFrameClock();
+
+	// Threshold/expiry hooks for countdowns
+	void onTimerAlarm(int index, qint64 thresholdMs, qint64 lateMs);
+
+	// Penalties: publish, mirror the count into the linked field, drive expiry
+	void commitPenalties();
+	void syncPenaltyField();
+	void updatePenaltyTickDriver();
+	void onPenaltyTick();
+	void refreshPenaltiesLabel();
 
 	// Hotkeys (dialog-driven, plugin-local)
 	QList<FlyHotkeyBinding> buildDefaultHotkeyBindings() const;
 	QList<FlyHotkeyBinding> buildMergedHotkeyBindings() const;
 	void applyHotkeyBindings(const QList<FlyHotkeyBinding> &bindings);
-	void clearAllShortcuts();
 
 	// Browser source sync
 	void updateBrowserSourceToCurrentResources();
 
+	// Localhost overlay server (serves index.html + in-memory state)
+	void startOverlayServer();
+
+	// Rolling counters for the diagnostics card and the periodic log line
+	struct DiagSample {
+		int64_t atUs = 0;
+		FlyStatePersister::Stats persist;
+		uint64_t saves = 0;
+		uint64_t widgetRebuilds = 0;
+	};
+	DiagSample diagSample() const;
+	QStringList diagnosticsLines(DiagSample &since) const; // rates since `since`, then advances it
+	void refreshDiagnostics();
+	void logDiagnostics();
+
+	// Stamp each saved version for the overlay's latency acks (st_.probe)
+	void setLatencyProbe(bool on);
+
 private:
 	QString dataDir_;
 	FlyState st_;
 
+	// Write-behind plugin.json persistence (off the UI thread)
+	FlyStatePersister persist_{kPersistCoalesceMs};
+
+	FlyHttpServer server_;
+
+	// Owns the match timers on a steady clock; st_.timers mirrors its snapshot
+	FlyTimerEngine timerEngine_;
+	QTimer *timerTick_ = nullptr;
+
+	// Concurrent penalty timers on a timing wheel; st_.penalties mirrors them
+	FlyPenaltyClock penalties_;
+	QTimer *penaltyTick_ = nullptr;
+	QLabel *penaltiesLbl_ = nullptr;
+
+	// Declared after server_ so it is torn down (tick callback removed) first
+	FlyFrameClock frameClock_;
+	QCheckBox *frameClockCheck_ = nullptr;
+
+	// Countdown threshold/expiry deadlines, re-armed on every timer change
+	FlyAlarmScheduler *alarms_ = nullptr;
+
+	// Feeds the CEF-free native scoreboard sources (idle when there are none)
+	FlyNativeScoreboard nativeBoard_;
+
 	// Scoreboard-level toggles
 	QCheckBox *swapSides_ = nullptr;
 	QCheckBox *showScoreboard_ = nullptr;
@@ -113,8 +210,13 @@ private:
 
 	// Quick controls layouts
 	QVBoxLayout *customFieldsLayout_ = nullptr;
+	QWidget *customFieldsHeader_ = nullptr;
 	QList<FlyCustomFieldUi> customFields_;
 
+	// Model/view presentation once there are more than kFieldsTableThreshold fields
+	QTableView *fieldsView_ = nullptr;
+	FlyCustomFieldsModel *fieldsModel_ = nullptr;
+
 	QVBoxLayout *timersLayout_ = nullptr;
 	QList<FlyTimerUi> timers_;
 
@@ -122,9 +224,20 @@ private:
 	QPushButton *setResourcesPathBtn_ = nullptr;
 	QPushButton *openResourcesFolderBtn_ = nullptr;
 
-	// Hotkey bindings + actual shortcuts
+	// Hotkey bindings + actual shortcuts, keyed by action ID
 	QList<FlyHotkeyBinding> hotkeyBindings_;
-	QList<QShortcut *> shortcuts_;
+	QHash<QString, QShortcut *> shortcuts_;
+
+	// Diagnostics counters
+	uint64_t saveCount_ = 0;      // saveState() calls
+	uint64_t widgetRebuilds_ = 0; // quick-control rows created
+	int64_t pendingActionUs_ = 0; // set while triggerAction() runs
+	bool probeEnabled_ = false;
+	QLabel *diagLbl_ = nullptr;
+	QTimer *diagTick_ = nullptr;
+	QTimer *diagLogTick_ = nullptr;
+	DiagSample diagUiSince_;
+	DiagSample diagLogSince_;
 };
 
 // Dock helpers (OBS frontend registration)
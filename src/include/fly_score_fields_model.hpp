@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QStyledItemDelegate>
+
+#include "fly_score_state.hpp"
+
+/**
+ * Table model over FlyState::custom_fields for the dock's large-table mode.
+ * Columns: visible (checkbox), label, home, guests.
+ *
+ * The model edits the dock's state in place and emits fieldEdited(row) so
+ * the dock can persist; it owns no copy of the data.
+ */
+class FlyCustomFieldsModel : public QAbstractTableModel {
+	Q_OBJECT
+public:
+	enum Column { ColVisible = 0, ColLabel, ColHome, ColAway, ColCount };
+
+	explicit FlyCustomFieldsModel(FlyState *state, QObject *parent = nullptr);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+	// State changed behind the model's back
+	void reload();
+	void refreshRow(int row);
+
+signals:
+	void fieldEdited(int row);
+
+private:
+	FlyState *st_ = nullptr;
+	int rows_ = 0;
+};
+
+/**
+ * Paints "− value +" into the home/guests cells and turns clicks on the
+ * painted buttons into ±1 edits. No per-row widgets are created.
+ */
+class FlyCustomFieldsDelegate : public QStyledItemDelegate {
+	Q_OBJECT
+public:
+	using QStyledItemDelegate::QStyledItemDelegate;
+
+	void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+	QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+	QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+			      const QModelIndex &index) const override;
+
+protected:
+	bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+			 const QModelIndex &index) override;
+};
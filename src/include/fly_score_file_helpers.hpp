@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+enum class FlyFsyncPolicy {
+	None,   // rename only; readers never see a partial file, but a power cut may lose the last write
+	Always, // fsync the temp file before the rename
+};
+
+/**
+ * Atomically replace `path` with `data`.
+ *
+ * Writes to a unique temp file next to `path`, flushes it (and fsyncs it,
+ * depending on `fsync`), then renames it over the target. Concurrent readers
+ * (e.g. the overlay polling plugin.json) see either the old or the new file,
+ * never a truncated one. On failure the temp file is removed and the target
+ * is left untouched.
+ */
+bool fly_atomic_write_file(const QString &path, const QByteArray &data,
+			   FlyFsyncPolicy fsync = FlyFsyncPolicy::None);
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "fly_score_timer_engine.hpp"
+
+/**
+ * Evaluates the timers at the OBS video frame timestamp.
+ *
+ * Hooks obs_add_tick_callback(); on every rendered frame the timer anchors
+ * (handed over from the UI thread with setTimers()) are evaluated at
+ * obs_get_video_frame_time(), mapped onto the engine's steady clock. When the
+ * formatted value of any timer changes at the configured precision, the sink
+ * receives a compact JSON document:
+ *
+ *   {"frame_ns":<u64>,"timers":[{"ms":<i64>,"text":"9.8"},...]}
+ *
+ * so tenths/hundredths flip exactly on frame boundaries instead of whenever
+ * the browser's own clock gets around to it. The sink runs on the OBS
+ * graphics thread and must not block.
+ */
+class FlyFrameClock {
+public:
+	using Sink = std::function<void(const QByteArray &json)>;
+
+	FlyFrameClock() = default;
+	~FlyFrameClock();
+
+	FlyFrameClock(const FlyFrameClock &) = delete;
+	FlyFrameClock &operator=(const FlyFrameClock &) = delete;
+
+	// decimals: 0 (mm:ss), 1 (tenths) or 2 (hundredths) below one minute
+	void start(Sink sink, int decimals);
+	void stop();
+	bool isRunning() const { return running_.load(); }
+
+	void setTimers(const QVector<FlyTimerEngine::Anchor> &anchors);
+
+	static QString formatMs(int64_t ms, int decimals);
+
+private:
+	static void onTick(void *param, float seconds);
+	void tick();
+
+	mutable std::mutex mtx_;
+	QVector<FlyTimerEngine::Anchor> anchors_;
+	QVector<QString> lastText_;
+	bool dirty_ = true;
+	int decimals_ = 1;
+	Sink sink_;
+
+	std::atomic<bool> running_{false};
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * End-to-end latency samples reported by the overlay's probe acks, kept per
+ * transport ("push" = SSE, "poll" = HTTP /state, "file" = plugin.json over
+ * file://).
+ *
+ * Each transport keeps a ring of its most recent kCapacity samples;
+ * percentiles are computed from that window on demand (nearest rank), so a
+ * change in conditions shows up within a few hundred acks. Thread-safe:
+ * acks arrive on the server thread, summaries are read on the UI thread.
+ */
+class FlyLatencyProbe {
+public:
+	static constexpr size_t kCapacity = 1024;
+
+	struct Summary {
+		uint64_t count = 0; // all samples ever recorded
+		int64_t p50_ms = 0;
+		int64_t p95_ms = 0;
+		int64_t p99_ms = 0;
+		int64_t max_ms = 0; // within the window
+	};
+
+	void record(const QString &transport, int64_t latencyMs);
+	void reset();
+
+	// Transports that have samples, sorted by name
+	QStringList transports() const;
+	Summary summary(const QString &transport) const;
+
+private:
+	struct Ring {
+		std::vector<int64_t> samples;
+		size_t next = 0;
+		uint64_t count = 0;
+	};
+
+	mutable std::mutex mtx_;
+	QHash<QString, Ring> rings_;
+};
@@ -1,21 +1,29 @@
 #pragma once
-#include <obs-module.h>
 #include "config.hpp"
 
+// fly_score_core is built without libobs; it logs through a swappable handler
+#ifdef FLY_SCORE_CORE
+#include "fly_score_core_log.hpp"
+#define FLY_BLOG fly_core_log
+#else
+#include <obs-module.h>
+#define FLY_BLOG blog
+#endif
+
 #ifndef LOG_TAG
 #define LOG_TAG "[" PLUGIN_NAME "]"
 #endif
 
-#define LOGI(fmt, ...) blog(LOG_INFO,    LOG_TAG " " fmt, ##__VA_ARGS__)
-#define LOGW(fmt, ...) blog(LOG_WARNING, LOG_TAG " " fmt, ##__VA_ARGS__)
-#define LOGE(fmt, ...) blog(LOG_ERROR,   LOG_TAG " " fmt, ##__VA_ARGS__)
+#define LOGI(fmt, ...) FLY_BLOG(LOG_INFO,    LOG_TAG " " fmt, ##__VA_ARGS__)
+#define LOGW(fmt, ...) FLY_BLOG(LOG_WARNING, LOG_TAG " " fmt, ##__VA_ARGS__)
+#define LOGE(fmt, ...) FLY_BLOG(LOG_ERROR,   LOG_TAG " " fmt, ##__VA_ARGS__)
 
 #if !defined(NDEBUG) || defined(ENABLE_LOG_DEBUG)
-#define LOGD(fmt, ...) blog(LOG_INFO, LOG_TAG " [D] " fmt, ##__VA_ARGS__)
+#define LOGD(fmt, ...) FLY_BLOG(LOG_INFO, LOG_TAG " [D] " fmt, ##__VA_ARGS__)
 #else
 #define LOGD(...) do {} while (0)
 #endif
 
-#define LOGI_T(tag, fmt, ...) blog(LOG_INFO,    "[" tag "] " fmt, ##__VA_ARGS__)
-#define LOGW_T(tag, fmt, ...) blog(LOG_WARNING, "[" tag "] " fmt, ##__VA_ARGS__)
-#define LOGE_T(tag, fmt, ...) blog(LOG_ERROR,   "[" tag "] " fmt, ##__VA_ARGS__)
+#define LOGI_T(tag, fmt, ...) FLY_BLOG(LOG_INFO,    "[" tag "] " fmt, ##__VA_ARGS__)
+#define LOGW_T(tag, fmt, ...) FLY_BLOG(LOG_WARNING, "[" tag "] " fmt, ##__VA_ARGS__)
+#define LOGE_T(tag, fmt, ...) FLY_BLOG(LOG_ERROR,   "[" tag "] " fmt, ##__VA_ARGS__)
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include <cstdint>
+
+#include "fly_score_renderer.hpp"
+#include "fly_score_state.hpp"
+#include "fly_score_timer_engine.hpp"
+
+/**
+ * Register the "fly_scoreboard_native" input source (kNativeSourceId).
+ *
+ * It is an async video source with no renderer of its own: every live
+ * instance is fed by the FlyNativeScoreboard owned by the dock. Call once
+ * from obs_module_load().
+ */
+void fly_register_native_source();
+
+/**
+ * Drives all native scoreboard sources from the UI thread.
+ *
+ * publish() hands over the state and timer anchors; the scoreboard is
+ * rasterized with FlyScoreRenderer and pushed with obs_source_output_video()
+ * only when the picture changed. While a visible timer runs, a single-shot
+ * timer is armed for the exact moment its mm:ss text flips next, so a running
+ * clock costs one small render per second and an idle scoreboard costs
+ * nothing. With no native source alive, nothing is rendered at all.
+ */
+class FlyNativeScoreboard : public QObject {
+	Q_OBJECT
+public:
+	explicit FlyNativeScoreboard(QObject *parent = nullptr);
+	~FlyNativeScoreboard() override;
+
+	void setDocRoot(const QString &docRoot);
+	void publish(const FlyState &st, const QVector<FlyTimerEngine::Anchor> &anchors);
+
+	// Render (if anything changed) and push to every live source
+	void refresh();
+
+private:
+	void armNextChange(int64_t steadyNow);
+
+	FlyScoreRenderer renderer_;
+	FlyState st_;
+	QVector<FlyTimerEngine::Anchor> anchors_;
+	QTimer digitTimer_;
+};
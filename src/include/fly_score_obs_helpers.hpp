@@ -1,10 +1,35 @@
 #pragma once
 #include <QString>
 
+#include "fly_score_state.hpp"
+
+enum class FlyBrowserSync {
+	Failed,    // no scene / could not create the source
+	Created,   // new source
+	Updated,   // settings changed; obs-browser reloads the page
+	Unchanged, // settings already matched; the page keeps running
+};
+
 /**
  * Ensure a Browser Source named kBrowserSourceName exists in the current scene
  * and points to the given URL or local index.html path. If it exists, it's updated; otherwise it's created.
+ * cfg sets its frame rate and "shutdown when not visible".
  *
- * Returns true on success, false if scene/browser-source is not available.
+ * Every obs_source_update makes obs-browser reload the page, so an existing source only receives
+ * the settings that actually differ, and none at all when they already match (Unchanged). Data
+ * changes should then reach the page through the overlay server instead.
  */
-bool fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex);
\ No newline at end of file
+FlyBrowserSync fly_ensure_browser_source_in_current_scene(const QString &urlOrLocalIndex,
+							  const FlyBrowserSourceConfig &cfg);
+
+/**
+ * Ensure the native (CPU-rendered, no CEF) scoreboard source exists in the
+ * current scene, at the same position a new Browser Source would get.
+ *
+ * Returns true if it already existed or was created.
+ */
+bool fly_ensure_native_source_in_current_scene();
+
+// Start/stop following the managed sources across scenes (obs_module_load/unload)
+void fly_source_tracking_start();
+void fly_source_tracking_stop();
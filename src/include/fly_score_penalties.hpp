@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+
+#include <cstdint>
+
+#include "fly_score_state.hpp"
+#include "fly_score_timer_engine.hpp"
+#include "fly_score_timing_wheel.hpp"
+
+/**
+ * Concurrent penalty (suspension) timers for both teams.
+ *
+ * Penalties run together with the game clock: setRunning() pauses or resumes
+ * all of them at once. While running, each one has a deadline in a
+ * FlyTimingWheel on the steady clock, so adding, removing and expiring a
+ * penalty is O(1) no matter how many are stacked. advance() reports every
+ * penalty whose deadline has passed and drops it; snapshot() only ever
+ * contains the active ones.
+ *
+ * Like FlyTimerEngine, wall-clock time is only used for the overlay anchor
+ * and to resume penalties persisted while running.
+ */
+class FlyPenaltyClock {
+public:
+	using ClockMs = FlyTimerEngine::ClockMs;
+
+	explicit FlyPenaltyClock(ClockMs steadyMs = {}, ClockMs wallMs = {});
+
+	void load(const QVector<FlyPenalty> &penalties, bool running);
+
+	// Active penalties, soonest expiry first
+	QVector<FlyPenalty> snapshot() const;
+
+	quint32 add(FlyFieldSide side, int64_t durationMs, const QString &label = QString());
+	bool remove(quint32 id);
+
+	// Id of the side's penalty that expires first, or 0
+	quint32 soonest(FlyFieldSide side) const;
+
+	int count(FlyFieldSide side) const { return counts_[side == FlyFieldSide::Away ? 1 : 0]; }
+	bool empty() const { return active_.isEmpty(); }
+
+	bool isRunning() const { return running_; }
+	bool setRunning(bool running);
+
+	int64_t tickMs() const { return wheel_.tickMs(); }
+
+	// Drop and return every penalty that has run out, in expiry order
+	QVector<FlyPenalty> advance();
+
+private:
+	struct Entry {
+		FlyPenalty penalty;        // remaining_ms is authoritative while paused
+		int64_t dueSteadyMs = 0;   // deadline while running
+		FlyTimingWheel::Handle handle = 0;
+	};
+
+	int64_t remainingMs(const Entry &e, int64_t steadyNow) const;
+	void arm(Entry &e, int64_t steadyNow);
+	void countChanged(FlyFieldSide side, int delta);
+
+	ClockMs steadyMs_;
+	ClockMs wallMs_;
+
+	FlyTimingWheel wheel_;
+	QHash<quint32, Entry> active_;
+	int counts_[2] = {0, 0};
+	quint32 nextId_ = 1;
+	bool running_ = false;
+};
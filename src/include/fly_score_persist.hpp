@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QString>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "fly_score_state.hpp"
+
+/**
+ * Write-behind persistence for plugin.json.
+ *
+ * The dock hands over immutable FlyState snapshots (cheap, Qt containers are
+ * implicitly shared). A dedicated worker thread serializes and writes them.
+ * Snapshots submitted for the same base dir within the coalescing window are
+ * collapsed (latest wins), so a burst of hotkey presses costs one write.
+ *
+ * submit() never touches the disk; only flush() (and the destructor) wait
+ * for the worker.
+ */
+class FlyStatePersister {
+public:
+	struct Stats {
+		uint64_t submitted = 0;   // snapshots handed to submit()
+		uint64_t written = 0;     // successful writes
+		uint64_t failed = 0;      // failed writes
+		uint64_t coalesced = 0;   // snapshots dropped in favour of a newer one
+		int64_t last_write_us = 0;    // serialize + write of the last snapshot
+		int64_t max_write_us = 0;
+		int64_t serialize_us_total = 0; // summed over all snapshots, for averages
+		int64_t write_us_total = 0;     // disk part only
+		uint64_t bytes_written = 0;
+		int64_t last_origin_latency_us = 0; // submit(originUs) -> on disk
+		int64_t max_origin_latency_us = 0;
+		int queue_depth = 0;      // snapshots waiting for the worker right now
+	};
+
+	explicit FlyStatePersister(int coalesceMs = 100);
+	~FlyStatePersister();
+
+	FlyStatePersister(const FlyStatePersister &) = delete;
+	FlyStatePersister &operator=(const FlyStatePersister &) = delete;
+
+	void setCoalesceWindowMs(int ms);
+	int coalesceWindowMs() const;
+
+	// Queue a snapshot for base_dir/plugin.json. Returns immediately.
+	// originUs (nowUs() clock) marks the user action behind the change; the
+	// time from the earliest one to the write lands in the latency stats.
+	void submit(const QString &baseDir, const FlyState &st, int64_t originUs = 0);
+
+	// Write everything queued so far and wait until it is on disk.
+	void flush();
+
+	Stats stats() const;
+
+	static int64_t nowUs();
+
+private:
+	struct Job {
+		QString baseDir;
+		FlyState state;
+		int64_t firstSubmitUs = 0;
+		int64_t originUs = 0;
+	};
+
+	void run();
+
+	mutable std::mutex mtx_;
+	std::condition_variable cv_;
+	std::condition_variable idleCv_;
+	std::deque<Job> queue_;
+	std::thread worker_;
+
+	int coalesceMs_ = 100;
+	bool flushRequested_ = false;
+	bool writing_ = false;
+	bool stop_ = false;
+
+	Stats stats_;
+};
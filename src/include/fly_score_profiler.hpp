@@ -0,0 +1,28 @@
+#pragma once
+
+#include <util/profiler.h>
+
+/**
+ * RAII wrapper around libobs profile_start()/profile_end().
+ *
+ * Scopes nest under whatever is active on the calling thread and show up in
+ * OBS's profiler summary (Help > Log Files) next to libobs' own. libobs keys
+ * scopes by the name pointer, so pass a string literal (FLY_PROFILE_SCOPE
+ * enforces that). Plugin-side only: fly_score_core does not link libobs.
+ */
+class FlyProfileScope {
+public:
+	explicit FlyProfileScope(const char *name) : name_(name) { profile_start(name_); }
+	~FlyProfileScope() { profile_end(name_); }
+
+	FlyProfileScope(const FlyProfileScope &) = delete;
+	FlyProfileScope &operator=(const FlyProfileScope &) = delete;
+
+private:
+	const char *name_;
+};
+
+#define FLY_PROFILE_CONCAT_(a, b) a##b
+#define FLY_PROFILE_CONCAT(a, b) FLY_PROFILE_CONCAT_(a, b)
+#define FLY_PROFILE_SCOPE(name) \
+	FlyProfileScope FLY_PROFILE_CONCAT(flyProfileScope_, __LINE__)("" name "")
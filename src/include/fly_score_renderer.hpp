@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+#include "fly_score_state.hpp"
+
+/**
+ * CPU rasterizer for the scoreboard, laid out like the default overlay
+ * (main bar with teams, logos, score and main clock; details row with the
+ * third stat and the second timer).
+ *
+ * Everything that only depends on the teams (backgrounds, accent stripes,
+ * logos, names) is painted once into a cached static layer; a render copies
+ * that layer and draws the dynamic text on top. update() compares the inputs
+ * with the previous render and does no painting at all when nothing visible
+ * changed, so callers can feed it as often as they like.
+ */
+class FlyScoreRenderer {
+public:
+	// The details row shows timers[1]; nothing beyond that is drawn
+	static constexpr int kRenderedTimers = 2;
+
+	FlyScoreRenderer(int width, int height);
+
+	// Whether st.timers[index] appears in the frame at all (a hidden details
+	// row hides timers[1]); only those timers can change it
+	static bool timerDrawn(const FlyState &st, int index);
+
+	// Logos are resolved relative to this folder
+	void setDocRoot(const QString &docRoot);
+
+	// timerMs[i] is the live value of st.timers[i]. Returns true when frame()
+	// changed; a hidden scoreboard yields a null frame().
+	bool update(const FlyState &st, const QVector<int64_t> &timerMs);
+
+	// Straight-alpha ARGB32, i.e. BGRA bytes on little-endian hosts
+	const QImage &frame() const { return frame_; }
+
+private:
+	void rebuildStaticLayer(const FlyState &st);
+	const QImage &logo(const QString &rel);
+
+	int width_;
+	int height_;
+	QString docRoot_;
+
+	QString staticKey_;
+	QImage staticLayer_; // premultiplied, painted once per team/logo change
+
+	QString dynamicKey_;
+	QImage frame_;
+
+	QHash<QString, QImage> logos_; // abs path -> scaled logo (null if unreadable)
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+#include "fly_score_latency.hpp"
+#include "fly_score_state.hpp"
+
+class QThread;
+class FlyHttpWorker;
+
+/**
+ * Minimal localhost HTTP server for the overlay.
+ *
+ * Runs on its own QThread, bound to 127.0.0.1. Serves:
+ *   /state, /plugin.json  -> the in-memory FlyState (never touches disk);
+ *                            /state?since=N returns a patch when possible
+ *   /events               -> Server-Sent Events; one "patch" message per change
+ *                            (full "state" on connect or when a patch won't do),
+ *                            plus "frame" messages from publishFrame() and
+ *                            "resync" from resync()
+ *   /ack                  -> latency probe echo from the overlay
+ *                            (?seq=N&sent=T&applied=T&via=push|poll|file)
+ *   /, /index.html, ...   -> files from the resources folder, falling back to the
+ *                            embedded defaults; served with ETags (304 on match)
+ *
+ * publish() is called from the owner's thread; it swaps the snapshot and
+ * wakes the server thread, which pushes to SSE clients. Bursts collapse into
+ * a single push, and nothing is sent while the state is idle.
+ */
+class FlyHttpServer : public QObject {
+	Q_OBJECT
+public:
+	explicit FlyHttpServer(QObject *parent = nullptr);
+	~FlyHttpServer() override;
+
+	bool start(const QString &docRoot, quint16 port);
+	void stop();
+
+	bool isRunning() const { return worker_ != nullptr; }
+	quint16 port() const { return port_; }
+
+	// http://127.0.0.1:<port>/index.html, or empty when not running
+	QString overlayUrl() const;
+
+	// http://127.0.0.1:<port>/ack (for FlyProbeStamp::ack), or empty
+	QString probeAckUrl() const;
+
+	// Samples from /ack; keeps collecting across restarts of the server
+	FlyLatencyProbe &latency() { return shared_.latency; }
+	const FlyLatencyProbe &latency() const { return shared_.latency; }
+
+	void setDocRoot(const QString &docRoot);
+	void publish(const FlyState &st);
+
+	// Refresh open overlays without a page reload: a full "state" event plus a
+	// "resync" event that makes them re-fetch images (e.g. new resources folder)
+	void resync();
+
+	// Frame-aligned timer values (see FlyFrameClock). Safe to call from any
+	// thread; only the newest payload is sent and frames are never queued up.
+	void publishFrame(const QByteArray &json);
+
+	// Shared between the owner and the server thread
+	struct Shared {
+		QMutex mtx;
+		QString docRoot;
+		FlyState state;
+		quint64 version = 0;
+		QByteArray frame;               // latest publishFrame() payload
+		FlyHttpWorker *worker = nullptr; // for publishFrame() from foreign threads
+		FlyLatencyProbe latency;         // has its own lock
+	};
+
+private:
+	Shared shared_;
+	std::atomic<bool> pushPending_{false};
+	std::atomic<bool> framePending_{false};
+	QThread *thread_ = nullptr;
+	FlyHttpWorker *worker_ = nullptr;
+	quint16 port_ = 0;
+};
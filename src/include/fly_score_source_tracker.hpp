@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+#include <mutex>
+
+#include <obs.h>
+
+/**
+ * Keeps a weak reference to one plugin-managed source and an index of the
+ * scenes whose items reference it, so "is it in this scene?" and "give me the
+ * source" are hash lookups instead of scene enumerations.
+ *
+ * The index is maintained from libobs signals: scene creation/destruction on
+ * the global handler and item_add/item_remove on every scene. Scene loading
+ * and duplication add items without signals, so those (and frontend scene
+ * collection changes) only mark the index stale; it is rebuilt once, on the
+ * next query. Thread-safe; signals arrive on arbitrary OBS threads.
+ */
+class FlySourceTracker {
+public:
+	// Matches sources with this id, and this name unless name is null
+	FlySourceTracker(const char *id, const char *name);
+	~FlySourceTracker();
+
+	FlySourceTracker(const FlySourceTracker &) = delete;
+	FlySourceTracker &operator=(const FlySourceTracker &) = delete;
+
+	void start();
+	void stop();
+
+	// Strong reference (caller releases), or nullptr when there is none
+	obs_source_t *source();
+
+	// Track a source we just created (or found some other way)
+	void adopt(obs_source_t *src);
+
+	// Whether any item of `scene` (a scene source) references the source
+	bool inScene(obs_source_t *scene);
+
+	// Number of scenes showing the source
+	int sceneCount();
+
+	// Drop the index; rebuilt on the next query
+	void invalidate();
+
+private:
+	bool matches(obs_source_t *src) const;
+	bool isTracked(obs_source_t *src) const; // caller holds mtx_
+
+	void connectScene(obs_source_t *scene);    // never called under mtx_
+	void disconnectScene(obs_source_t *scene); // never called under mtx_
+	void ensureIndex();
+
+	static void onSourceCreate(void *param, calldata_t *cd);
+	static void onSourceDestroy(void *param, calldata_t *cd);
+	static void onItemAdd(void *param, calldata_t *cd);
+	static void onItemRemove(void *param, calldata_t *cd);
+
+	const char *id_;
+	const char *name_;
+
+	std::mutex mtx_;
+	bool started_ = false;
+	bool stale_ = true;
+	obs_weak_source_t *weak_ = nullptr;
+	QHash<obs_source_t *, int> itemsPerScene_; // scene -> items referencing the source
+	QSet<obs_source_t *> connected_;           // scenes with item_add/item_remove hooked
+};
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
 #include <QString>
 #include <QVector>
 #include <string>
 
+#include "fly_score_file_helpers.hpp"
+
 struct FlyTeam {
 	QString title;
 	QString subtitle;
@@ -11,9 +17,12 @@ struct FlyTeam {
 	uint32_t color = 0xFFFFFF;
 };
 
+// Resolved once when the state is parsed; "countdown"/"countup" only exist on disk
+enum class FlyTimerMode { Countdown, Countup };
+
 struct FlyTimer {
 	QString label;
-	QString mode;
+	FlyTimerMode mode = FlyTimerMode::Countdown;
 	bool running = false;
 	long long initial_ms = 0;
 	long long remaining_ms = 0;
@@ -21,6 +30,25 @@ struct FlyTimer {
 	bool visible = true;
 };
 
+enum class FlyFieldSide { Home, Away };
+
+// Timed suspension (e.g. handball 2', hockey minor). Only active penalties are
+// kept in the state; expired ones are dropped by FlyPenaltyClock.
+struct FlyPenalty {
+	quint32 id = 0;
+	FlyFieldSide side = FlyFieldSide::Home;
+	QString label;
+	long long duration_ms = 0;
+	long long remaining_ms = 0;
+	long long last_tick_ms = 0; // wall anchor while running (overlay only)
+	bool running = false;
+};
+
+struct FlyPenaltyConfig {
+	long long duration_ms = 120000;
+	int field_index = -1; // custom field mirroring the active count per side; -1 = none
+};
+
 struct FlyCustomField {
 	QString label;
 	int  home    = 0;
@@ -28,7 +56,47 @@ struct FlyCustomField {
 	bool visible = true;
 };
 
+struct FlyServerConfig {
+	bool enabled = true;
+	int  port    = 8089;
+};
+
+// How the plugin-managed Browser Source is configured. obs-browser recreates
+// the page whenever these change, so they are applied on sync, not per frame.
+struct FlyBrowserSourceConfig {
+	int  fps = 30;                     // 0 = follow the canvas frame rate
+	bool shutdown_when_hidden = true;  // drop the CEF renderer while not visible
+};
+
+// Optional OBS-frame-aligned timer publishing (see FlyFrameClock)
+struct FlyFrameClockConfig {
+	bool enabled = false;
+	int  decimals = 1; // 0, 1 (tenths) or 2 (hundredths) below one minute
+};
+
+// Countdown threshold alarms (see FlyAlarmScheduler) and what happens at 0
+struct FlyAlarmConfig {
+	QVector<long long> thresholds_ms{60000, 10000, 0};
+	bool auto_pause = true; // stop a countdown when it reaches 0
+	QString expiry_scene;   // switch to this scene at 0; empty = off
+	QString expiry_action;  // hotkey action ID to trigger at 0; empty = off
+};
+
+// Latency probe stamp (see FlyLatencyProbe). Set per saved version while the
+// probe runs; the overlay echoes it to `ack` once the version is on screen.
+// Written only while seq != 0 and never read back from disk.
+struct FlyProbeStamp {
+	quint64 seq = 0;
+	qint64 sent_ms = 0; // wall clock, same machine as the overlay
+	QString ack;        // absolute /ack URL of the overlay server; empty = none
+};
+
 struct FlyState {
+	FlyServerConfig server;
+	FlyBrowserSourceConfig browser;
+	FlyFrameClockConfig frame_clock;
+	FlyAlarmConfig alarms;
+
 	FlyTeam home;
 	FlyTeam away;
 
@@ -37,14 +105,92 @@ struct FlyState {
 
 	QVector<FlyCustomField> custom_fields;
 	QVector<FlyTimer> timers;
+
+	FlyPenaltyConfig penalty;
+	QVector<FlyPenalty> penalties;
+
+	FlyProbeStamp probe;
 };
 
+// Upper bound of a custom field value (matches the dock spinboxes)
+inline constexpr int kFlyFieldValueMax = 999;
+
+// Typed single-element mutations. They clamp, touch only custom_fields[index]
+// and return true when the stored value actually changed.
+//
+// There is no dirty set: a false return skips the save, the overlay server's
+// FlyStateHistory already narrows pushes to the changed element (e.g. a
+// "custom_fields[3].home" patch), and plugin.json is always rewritten whole.
+bool fly_state_set_field_value(FlyState &st, int index, FlyFieldSide side, int value);
+bool fly_state_set_field_visible(FlyState &st, int index, bool visible);
+
+FlyTimerMode fly_timer_mode_from_string(const QString &s);
+QString      fly_timer_mode_to_string(FlyTimerMode mode);
+
+QJsonObject fly_state_to_json(const FlyState &st);
+bool        fly_state_from_json(const QJsonObject &j, FlyState &out);
+
 bool     fly_state_read_json(const std::string &base_dir, std::string &out_json);
 bool     fly_state_write_json(const std::string &base_dir, const std::string &json);
 bool     fly_state_load(const QString &base_dir, FlyState &out);
 bool     fly_state_save(const QString &base_dir, const FlyState &st);
-QString  fly_data_dir();
-bool     fly_ensure_webroot(QString *outBaseDir = nullptr);
+
+// fly_state_save() in two steps, for callers that time them separately
+QByteArray fly_state_serialize(const FlyState &st);
+bool       fly_state_save_serialized(const QString &base_dir, const QByteArray &json);
+
 FlyState fly_state_make_defaults();
 bool     fly_state_reset_defaults(const QString &base_dir);
 bool fly_state_ensure_json_exists(const QString &base_dir, const FlyState *writeState = nullptr);
+
+// plugin.json writes are always atomic (temp + rename); this only controls fsync.
+void     fly_state_set_fsync_policy(FlyFsyncPolicy policy);
+
+// -----------------------------------------------------------------------------
+// Versioned deltas between serialized states
+// -----------------------------------------------------------------------------
+
+// One patch step. Paths use the overlay's syntax, e.g. "custom_fields[3].home".
+struct FlyStatePatchOp {
+	enum Kind { Set, Remove };
+
+	Kind kind = Set;
+	QString path;
+	QJsonValue value;
+};
+
+using FlyStatePatch = QVector<FlyStatePatchOp>;
+
+// Ordered ops turning `from` into `to`. Arrays whose length changed are replaced whole.
+FlyStatePatch fly_state_diff(const QJsonObject &from, const QJsonObject &to);
+QJsonArray    fly_state_patch_to_json(const FlyStatePatch &patch);
+
+/**
+ * Serialized state plus a bounded ring of the most recent patches.
+ * Every commit that changes something bumps the revision; a client that is
+ * at most `capacity` revisions behind can catch up with patchesSince().
+ */
+class FlyStateHistory {
+public:
+	explicit FlyStateHistory(int capacity = 64);
+
+	// Returns the revision of `st` (unchanged when `st` equals the current state)
+	quint64 commit(const FlyState &st);
+
+	quint64 revision() const { return revision_; }
+	const QJsonObject &current() const { return current_; }
+
+	// Ops from `since` to revision(); false when `since` is unknown or too old
+	bool patchesSince(quint64 since, FlyStatePatch &out) const;
+
+private:
+	struct Entry {
+		quint64 revision = 0;
+		FlyStatePatch ops;
+	};
+
+	QVector<Entry> ring_;
+	int count_ = 0;
+	quint64 revision_ = 0;
+	QJsonObject current_;
+};
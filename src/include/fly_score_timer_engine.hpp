@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+
+#include "fly_score_state.hpp"
+
+/**
+ * Owns the match timers and advances them on a monotonic clock.
+ *
+ * Elapsed time is always measured with the steady clock, so NTP steps or
+ * DST/clock changes on the host never make the game clock jump. Wall-clock
+ * time is only used for two things:
+ *   - snapshot() stamps each running timer with a wall anchor (last_tick_ms)
+ *     for the overlay, which re-anchors it to its own monotonic clock;
+ *   - load() resumes a timer that was running when the state was persisted
+ *     (e.g. across an OBS restart), the one case a steady clock cannot bridge.
+ *
+ * Every mutating operation returns true when something changed. The engine is
+ * not thread-safe; the dock drives it from the UI thread.
+ */
+class FlyTimerEngine {
+public:
+	using ClockMs = std::function<int64_t()>;
+
+	// Enough to evaluate a timer at any steady time, e.g. on another thread
+	struct Anchor {
+		bool running = false;
+		FlyTimerMode mode = FlyTimerMode::Countdown;
+		int64_t valueMs = 0;        // value at steadyAnchorMs
+		int64_t steadyAnchorMs = 0;
+	};
+
+	// The default steady clock (std::chrono::steady_clock, in ms)
+	static int64_t steadyNowMs();
+
+	static int64_t valueAt(const Anchor &a, int64_t steadyMs);
+
+	// Both clocks are injectable; empty means std::chrono::steady_clock and the
+	// system wall clock respectively.
+	explicit FlyTimerEngine(ClockMs steadyMs = {}, ClockMs wallMs = {});
+
+	// Adopt the persisted timers (labels, modes, values and running state).
+	void load(const QVector<FlyTimer> &timers);
+
+	// Persistable / publishable copy: remaining_ms is the value at the anchor,
+	// last_tick_ms the matching wall-clock time for running timers.
+	QVector<FlyTimer> snapshot() const;
+
+	QVector<Anchor> anchors() const;
+
+	int count() const { return int(timers_.size()); }
+
+	// Whether any timer's value is still moving: running, and not a countdown
+	// that has already reached 0 (those stay running until paused)
+	bool anyRunning() const;
+
+	bool isRunning(int index) const;
+	FlyTimerMode mode(int index) const;
+
+	// Current value in ms (remaining for countdown, elapsed for countup)
+	int64_t valueMs(int index) const;
+
+	bool start(int index);
+	bool pause(int index);
+	bool toggle(int index);
+
+	// Back to initial_ms and stopped
+	bool reset(int index);
+	bool resetAll();
+
+	// Stopped timers only: set both the preset and the current value
+	bool setPreset(int index, int64_t ms);
+
+	// Shift the current value by deltaMs (running or not), clamped at 0
+	bool adjust(int index, int64_t deltaMs);
+
+	bool setVisible(int index, bool visible);
+
+private:
+	struct Slot {
+		FlyTimer timer;              // config + value at steadyAnchorMs
+		int64_t steadyAnchorMs = 0;  // steady time the value was last folded in
+	};
+
+	bool valid(int index) const { return index >= 0 && index < timers_.size(); }
+	int64_t liveValue(const Slot &s, int64_t steadyNow) const;
+
+	// Fold the elapsed time into the stored value and move the anchor to now
+	void rebase(Slot &s, int64_t steadyNow);
+
+	ClockMs steadyMs_;
+	ClockMs wallMs_;
+	QVector<Slot> timers_;
+};
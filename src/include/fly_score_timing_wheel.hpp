@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Hierarchical timing wheel (4 levels x 64 slots).
+ *
+ * Deadlines are rounded up to whole ticks, so nothing fires early; the fire
+ * callback still receives the exact due time that was scheduled. With the
+ * default 100 ms tick the wheel spans 64^4 ticks (~19 days); later deadlines
+ * are parked in the last level and re-cascaded until they come into range.
+ *
+ *   schedule / cancel : O(1) (intrusive lists in a node pool, no allocation
+ *                       once the pool has grown)
+ *   advance           : O(ticks elapsed + timers fired/cascaded); an empty
+ *                       wheel jumps straight to the target tick
+ *
+ * Handles carry a generation, so cancelling a fired or recycled handle is a
+ * harmless no-op. Not thread-safe.
+ */
+class FlyTimingWheel {
+public:
+	using Handle = uint64_t; // 0 is never a valid handle
+	using FireFn = std::function<void(uint64_t payload, int64_t dueMs)>;
+
+	explicit FlyTimingWheel(int64_t tickMs = 100, int64_t startMs = 0);
+
+	int64_t tickMs() const { return tickMs_; }
+	size_t size() const { return live_; }
+	bool empty() const { return live_ == 0; }
+
+	Handle schedule(int64_t dueMs, uint64_t payload);
+	bool cancel(Handle h);
+
+	// Fire everything due at or before nowMs, in tick order. Callbacks run after
+	// each tick's slot has been detached, so they may schedule or cancel freely.
+	void advance(int64_t nowMs, const FireFn &fire);
+
+	// Drop everything and restart the wheel at startMs
+	void reset(int64_t startMs);
+
+private:
+	static constexpr int kLevels = 4;
+	static constexpr int kBits = 6;
+	static constexpr int kSlots = 1 << kBits;
+	static constexpr uint64_t kSlotMask = kSlots - 1;
+
+	struct Node {
+		int64_t dueMs = 0;
+		int64_t dueTick = 0;
+		uint64_t payload = 0;
+		uint32_t gen = 1;
+		int32_t prev = -1;
+		int32_t next = -1;
+		int16_t level = -1; // -1: free
+		int16_t slot = -1;
+	};
+
+	int64_t tickFor(int64_t ms) const;
+
+	void place(int32_t idx);
+	void link(int32_t idx, int level, int slot);
+	void unlink(int32_t idx);
+	void release(int32_t idx);
+	void cascade(int level);
+
+	int64_t tickMs_;
+	int64_t currentTick_; // last processed tick
+	size_t live_ = 0;
+
+	std::vector<Node> nodes_;
+	std::vector<int32_t> free_;
+	int32_t heads_[kLevels][kSlots];
+
+	struct Fired {
+		uint64_t payload;
+		int64_t dueMs;
+	};
+	std::vector<Fired> fired_; // reused between ticks
+};
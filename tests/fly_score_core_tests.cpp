@@ -0,0 +1,440 @@
+// fly_score_core_tests: checks for the Qt-Core-only parts of the plugin.
+//
+// Plain asserts, no test framework: every failed CHECK prints its location
+// and the process exits non-zero, which is all ctest needs. Covers the state
+// JSON round trip, diffs and FlyStateHistory catch-up, action ID parsing, and
+// the timer engine and timing wheel on injected clocks.
+
+#include "fly_score_actions.hpp"
+#include "fly_score_state.hpp"
+#include "fly_score_timer_engine.hpp"
+#include "fly_score_timing_wheel.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                                     \
+	do {                                                                            \
+		if (!(cond)) {                                                          \
+			std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+			++g_failures;                                                   \
+		}                                                                       \
+	} while (0)
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+static FlyState sample_state()
+{
+	FlyState st = fly_state_make_defaults();
+	st.home.title = QStringLiteral("Home FC");
+	st.home.subtitle = QStringLiteral("HFC");
+	st.home.logo = QStringLiteral("home.png");
+	st.home.color = 0x112233;
+	st.away.title = QStringLiteral("Guests");
+	st.away.color = 0xABCDEF;
+	st.swap_sides = true;
+	st.show_scoreboard = false;
+
+	st.server.port = 9001;
+	st.browser.fps = 24;
+	st.frame_clock.enabled = true;
+	st.alarms.thresholds_ms = {30000, 0};
+	st.alarms.expiry_scene = QStringLiteral("Break");
+
+	st.custom_fields[0].home = 3;
+	st.custom_fields[0].away = 1;
+	st.custom_fields.push_back({QStringLiteral("Corners"), 4, 7, false});
+
+	FlyTimer t;
+	t.label = QStringLiteral("Extra");
+	t.mode = FlyTimerMode::Countup;
+	t.initial_ms = 0;
+	t.remaining_ms = 12345;
+	t.visible = false;
+	st.timers.push_back(t);
+
+	FlyPenalty p;
+	p.id = 7;
+	p.side = FlyFieldSide::Away;
+	p.label = QStringLiteral("2'");
+	p.duration_ms = 120000;
+	p.remaining_ms = 45000;
+	st.penalties.push_back(p);
+	return st;
+}
+
+// Minimal applier for FlyStatePatch paths ("custom_fields[3].home")
+struct PathKey {
+	bool index = false;
+	QString key;
+	int idx = 0;
+};
+
+static QVector<PathKey> split_path(const QString &path)
+{
+	static const QRegularExpression re(QStringLiteral("([^[.\\]]+)|\\[(\\d+)\\]"));
+	QVector<PathKey> keys;
+	auto it = re.globalMatch(path);
+	while (it.hasNext()) {
+		const auto m = it.next();
+		PathKey k;
+		if (m.capturedLength(1)) {
+			k.key = m.captured(1);
+		} else {
+			k.index = true;
+			k.idx = m.captured(2).toInt();
+		}
+		keys.push_back(k);
+	}
+	return keys;
+}
+
+static QJsonValue apply_at(const QJsonValue &node, const QVector<PathKey> &keys, int i, const FlyStatePatchOp &op)
+{
+	const PathKey &k = keys[i];
+	const bool last = i == keys.size() - 1;
+
+	if (k.index) {
+		QJsonArray arr = node.toArray();
+		if (last)
+			arr[k.idx] = op.value;
+		else
+			arr[k.idx] = apply_at(arr.at(k.idx), keys, i + 1, op);
+		return arr;
+	}
+
+	QJsonObject obj = node.toObject();
+	if (last && op.kind == FlyStatePatchOp::Remove)
+		obj.remove(k.key);
+	else if (last)
+		obj[k.key] = op.value;
+	else
+		obj[k.key] = apply_at(obj.value(k.key), keys, i + 1, op);
+	return obj;
+}
+
+static QJsonObject apply_patch(QJsonObject doc, const FlyStatePatch &ops)
+{
+	for (const FlyStatePatchOp &op : ops) {
+		const QVector<PathKey> keys = split_path(op.path);
+		if (!keys.isEmpty())
+			doc = apply_at(doc, keys, 0, op).toObject();
+	}
+	return doc;
+}
+
+// -----------------------------------------------------------------------------
+// State JSON
+// -----------------------------------------------------------------------------
+
+static void test_state_round_trip()
+{
+	const FlyState st = sample_state();
+	const QJsonObject j = fly_state_to_json(st);
+
+	FlyState back;
+	CHECK(fly_state_from_json(j, back));
+	CHECK(fly_state_to_json(back) == j);
+
+	CHECK(back.home.title == st.home.title);
+	CHECK(back.home.color == st.home.color);
+	CHECK(back.swap_sides && !back.show_scoreboard);
+	CHECK(back.server.port == 9001);
+	CHECK(back.browser.fps == 24);
+	CHECK(back.frame_clock.enabled);
+	CHECK(back.alarms.thresholds_ms == st.alarms.thresholds_ms);
+	CHECK(back.custom_fields.size() == st.custom_fields.size());
+	CHECK(back.custom_fields.last().away == 7 && !back.custom_fields.last().visible);
+	CHECK(back.timers.size() == st.timers.size());
+	CHECK(back.timers.last().mode == FlyTimerMode::Countup);
+	CHECK(back.timers.last().remaining_ms == 12345);
+	CHECK(back.penalties.size() == 1 && back.penalties[0].side == FlyFieldSide::Away);
+
+	// Serialized bytes go through the same path
+	FlyState parsed;
+	CHECK(fly_state_from_json(QJsonDocument::fromJson(fly_state_serialize(st)).object(), parsed));
+	CHECK(fly_state_to_json(parsed) == j);
+
+	// The probe stamp is written while it runs but never read back
+	FlyState stamped = st;
+	stamped.probe.seq = 5;
+	stamped.probe.sent_ms = 1000;
+	const QJsonObject sj = fly_state_to_json(stamped);
+	CHECK(sj.contains(QStringLiteral("probe")));
+	CHECK(!j.contains(QStringLiteral("probe")));
+	FlyState unstamped;
+	CHECK(fly_state_from_json(sj, unstamped));
+	CHECK(unstamped.probe.seq == 0);
+}
+
+static void test_state_diff()
+{
+	const FlyState a = sample_state();
+	FlyState b = a;
+	b.custom_fields[1].home = 5;
+	b.home.title = QStringLiteral("Renamed");
+
+	const QJsonObject ja = fly_state_to_json(a);
+	const QJsonObject jb = fly_state_to_json(b);
+
+	CHECK(fly_state_diff(ja, ja).isEmpty());
+
+	const FlyStatePatch ops = fly_state_diff(ja, jb);
+	CHECK(ops.size() == 2);
+	bool sawField = false;
+	for (const FlyStatePatchOp &op : ops)
+		sawField |= op.path == QLatin1String("custom_fields[1].home") && op.value.toInt() == 5;
+	CHECK(sawField);
+	CHECK(apply_patch(ja, ops) == jb);
+
+	// Length changes replace the array; removed keys come out as Remove
+	FlyState c = b;
+	c.penalties.clear();
+	c.custom_fields.push_back({QStringLiteral("Fouls"), 1, 2, true});
+	QJsonObject jc = fly_state_to_json(c);
+	jc.remove(QStringLiteral("penalty"));
+	const FlyStatePatch ops2 = fly_state_diff(jb, jc);
+	CHECK(apply_patch(jb, ops2) == jc);
+
+	bool sawRemove = false;
+	for (const FlyStatePatchOp &op : ops2)
+		sawRemove |= op.kind == FlyStatePatchOp::Remove && op.path == QLatin1String("penalty");
+	CHECK(sawRemove);
+}
+
+static void test_state_history()
+{
+	FlyStateHistory h(4);
+	FlyState st = sample_state();
+
+	const quint64 r1 = h.commit(st);
+	CHECK(r1 == h.revision());
+	CHECK(h.commit(st) == r1); // unchanged state, same revision
+	const QJsonObject at1 = h.current();
+
+	for (int i = 1; i <= 3; ++i) {
+		st.custom_fields[0].home = 10 + i;
+		h.commit(st);
+	}
+	CHECK(h.revision() == r1 + 3);
+
+	// A client at r1 catches up with one combined patch
+	FlyStatePatch ops;
+	CHECK(h.patchesSince(r1, ops));
+	CHECK(apply_patch(at1, ops) == h.current());
+
+	// Up to date: nothing to apply
+	ops.clear();
+	CHECK(h.patchesSince(h.revision(), ops));
+	CHECK(ops.isEmpty());
+
+	// Beyond the ring (capacity 4) or from the future: full state needed
+	for (int i = 0; i < 4; ++i) {
+		st.timers[0].remaining_ms += 1000;
+		h.commit(st);
+	}
+	CHECK(!h.patchesSince(r1, ops));
+	CHECK(!h.patchesSince(h.revision() + 1, ops));
+}
+
+// -----------------------------------------------------------------------------
+// Actions
+// -----------------------------------------------------------------------------
+
+static void test_action_parse()
+{
+	CHECK(fly_action_parse(QStringLiteral("swap_sides")) == (FlyAction{FlyActionKind::SwapSides, -1}));
+	CHECK(fly_action_parse(QStringLiteral("toggle_scoreboard")).kind == FlyActionKind::ToggleScoreboard);
+	CHECK(fly_action_parse(QStringLiteral("field_3_home_inc")) == (FlyAction{FlyActionKind::FieldHomeInc, 3}));
+	CHECK(fly_action_parse(QStringLiteral("field_0_away_dec")) == (FlyAction{FlyActionKind::FieldAwayDec, 0}));
+	CHECK(fly_action_parse(QStringLiteral("field_12_toggle")) == (FlyAction{FlyActionKind::FieldToggle, 12}));
+	CHECK(fly_action_parse(QStringLiteral("timer_1_toggle")) == (FlyAction{FlyActionKind::TimerToggle, 1}));
+	CHECK(fly_action_parse(QStringLiteral("penalty_away_remove")).kind == FlyActionKind::PenaltyAwayRemove);
+
+	for (const char *bad : {"", "bogus", "field_x_home_inc", "field_-1_toggle", "field_2_sideways", "timer_1_reset",
+				"field__toggle", "timer_"}) {
+		CHECK(!fly_action_parse(QString::fromLatin1(bad)).isValid());
+	}
+
+	// fly_action_id() is the inverse
+	for (const char *id : {"swap_sides", "toggle_scoreboard", "field_3_home_inc", "field_3_home_dec",
+			       "field_0_away_inc", "field_9_away_dec", "field_4_toggle", "timer_2_toggle",
+			       "penalty_home_add", "penalty_home_remove", "penalty_away_add", "penalty_away_remove"}) {
+		const QString s = QString::fromLatin1(id);
+		CHECK(fly_action_id(fly_action_parse(s)) == s);
+	}
+	CHECK(fly_action_id(FlyAction{}).isEmpty());
+
+	CHECK(fly_action_group(FlyActionKind::FieldHomeInc) == FlyActionGroup::Fields);
+	CHECK(fly_action_group(FlyActionKind::TimerToggle) == FlyActionGroup::Timers);
+	CHECK(fly_action_group(FlyActionKind::SwapSides) == FlyActionGroup::Scoreboard);
+}
+
+// -----------------------------------------------------------------------------
+// Timer engine (injected clocks)
+// -----------------------------------------------------------------------------
+
+static FlyTimer make_timer(FlyTimerMode mode, long long initialMs)
+{
+	FlyTimer t;
+	t.label = QStringLiteral("T");
+	t.mode = mode;
+	t.initial_ms = initialMs;
+	t.remaining_ms = initialMs;
+	return t;
+}
+
+static void test_timer_engine()
+{
+	int64_t steady = 5000;
+	int64_t wall = 1700000000000;
+	FlyTimerEngine eng([&steady]() { return steady; }, [&wall]() { return wall; });
+
+	eng.load({make_timer(FlyTimerMode::Countdown, 60000), make_timer(FlyTimerMode::Countup, 0)});
+	CHECK(eng.count() == 2);
+	CHECK(!eng.anyRunning());
+
+	// Countdown runs on the steady clock only
+	CHECK(eng.start(0));
+	CHECK(!eng.start(0));
+	steady += 1500;
+	wall += 3600 * 1000; // a wall clock step must not move the game clock
+	CHECK(eng.valueMs(0) == 58500);
+	CHECK(eng.anyRunning());
+
+	CHECK(eng.pause(0));
+	steady += 5000;
+	CHECK(eng.valueMs(0) == 58500);
+	CHECK(!eng.anyRunning());
+
+	// Snapshot: the value at now plus a wall anchor while running
+	CHECK(eng.toggle(0));
+	steady += 500;
+	const QVector<FlyTimer> snap = eng.snapshot();
+	CHECK(snap[0].running && snap[0].remaining_ms == 58000 && snap[0].last_tick_ms == wall);
+	CHECK(!snap[1].running && snap[1].last_tick_ms == 0);
+
+	const QVector<FlyTimerEngine::Anchor> anchors = eng.anchors();
+	CHECK(FlyTimerEngine::valueAt(anchors[0], steady + 1000) == 57000);
+	CHECK(FlyTimerEngine::valueAt(anchors[0], steady + 100000) == 0);
+
+	// Expired countdowns stay running but no longer count as moving
+	steady += 100000;
+	CHECK(eng.valueMs(0) == 0);
+	CHECK(eng.isRunning(0));
+	CHECK(!eng.anyRunning());
+
+	// Countup, adjust and clamping
+	CHECK(eng.start(1));
+	steady += 2000;
+	CHECK(eng.valueMs(1) == 2000);
+	CHECK(eng.adjust(1, 500));
+	CHECK(eng.valueMs(1) == 2500);
+	CHECK(eng.adjust(1, -100000));
+	CHECK(eng.valueMs(1) == 0);
+	CHECK(!eng.adjust(1, 0));
+
+	// Presets only apply to stopped timers; reset restores them
+	CHECK(!eng.setPreset(1, 9000));
+	CHECK(eng.resetAll());
+	CHECK(!eng.anyRunning());
+	CHECK(eng.valueMs(0) == 60000);
+	CHECK(eng.setPreset(0, 30000));
+	CHECK(!eng.setPreset(0, 30000));
+	CHECK(eng.valueMs(0) == 30000);
+	CHECK(!eng.reset(0));
+
+	CHECK(eng.setVisible(0, false));
+	CHECK(!eng.setVisible(0, false));
+	CHECK(!eng.start(5));
+
+	// A timer persisted while running resumes from its wall anchor
+	FlyTimer persisted = make_timer(FlyTimerMode::Countdown, 60000);
+	persisted.remaining_ms = 10000;
+	persisted.running = true;
+	persisted.last_tick_ms = wall - 2000;
+	eng.load({persisted});
+	CHECK(eng.valueMs(0) == 8000);
+	steady += 1000;
+	CHECK(eng.valueMs(0) == 7000);
+}
+
+// -----------------------------------------------------------------------------
+// Timing wheel
+// -----------------------------------------------------------------------------
+
+static void test_timing_wheel()
+{
+	FlyTimingWheel wheel(100, 0);
+	std::vector<std::pair<uint64_t, int64_t>> fired;
+	auto fire = [&fired](uint64_t payload, int64_t dueMs) { fired.emplace_back(payload, dueMs); };
+
+	const FlyTimingWheel::Handle a = wheel.schedule(250, 1);
+	const FlyTimingWheel::Handle b = wheel.schedule(1000, 2);
+	const FlyTimingWheel::Handle c = wheel.schedule(7 * 24 * 3600 * 1000LL, 3); // upper levels
+	wheel.schedule(5000, 4);
+	CHECK(a && b && c);
+	CHECK(wheel.size() == 4);
+
+	// Never early: 250 rounds up to the 300 ms tick
+	wheel.advance(200, fire);
+	CHECK(fired.empty());
+	wheel.advance(300, fire);
+	CHECK(fired.size() == 1 && fired[0] == std::make_pair(uint64_t(1), int64_t(250)));
+
+	// Cancelling a pending handle works once; fired handles are no-ops
+	CHECK(wheel.cancel(b));
+	CHECK(!wheel.cancel(b));
+	CHECK(!wheel.cancel(a));
+
+	wheel.advance(10000, fire);
+	CHECK(fired.size() == 2 && fired[1].first == 4 && fired[1].second == 5000);
+
+	// Far deadlines cascade down and fire at their exact due time
+	wheel.advance(7 * 24 * 3600 * 1000LL + 100, fire);
+	CHECK(fired.size() == 3 && fired[2].first == 3 && fired[2].second == 7 * 24 * 3600 * 1000LL);
+	CHECK(wheel.empty());
+
+	// Callbacks may reschedule
+	wheel.reset(0);
+	fired.clear();
+	wheel.schedule(100, 10);
+	wheel.advance(1000, [&](uint64_t payload, int64_t dueMs) {
+		fired.emplace_back(payload, dueMs);
+		if (payload == 10)
+			wheel.schedule(dueMs + 300, 11);
+	});
+	CHECK(fired.size() == 2 && fired[1].first == 11 && fired[1].second == 400);
+}
+
+int main()
+{
+	test_state_round_trip();
+	test_state_diff();
+	test_state_history();
+	test_action_parse();
+	test_timer_engine();
+	test_timing_wheel();
+
+	if (g_failures) {
+		std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+		return 1;
+	}
+	std::printf("all checks passed\n");
+	return 0;
+}